@@ -19,6 +19,14 @@ static uint32_t lastshow = 0;
 uint32_t _frame_cnt=0;
 uint32_t _retry_cnt=0;
 
+// Asynchronous show state, read by the drivers that send in the background
+bool _show_async = false;
+show_done_func _show_done_func = NULL;
+void *_show_done_arg = NULL;
+
+// Set by showDirty: leave out the controllers that have not changed
+static bool _show_dirty_only = false;
+
 // uint32_t CRGBW::Squant = ((uint32_t)((__TIME__[4]-'0') * 28))<<16 | ((__TIME__[6]-'0')*50)<<8 | ((__TIME__[7]-'0')*28);
 
 CFastLED::CFastLED() {
@@ -36,8 +44,20 @@ CLEDController &CFastLED::addLeds(CLEDController *pLed,
   int nOffset = (nLedsIfOffset > 0) ? nLedsOrOffset : 0;
   int nLeds = (nLedsIfOffset > 0) ? nLedsIfOffset : nLedsOrOffset;
 
+  pLed->setLeds(data + nOffset, nLeds);
   pLed->init();
+  FastLED.setMaxRefreshRate(pLed->getMaxRefreshRate(),true);
+  return *pLed;
+}
+
+CLEDController &CFastLED::addLeds(CLEDController *pLed,
+    struct CRGBW16 *data,
+    int nLedsOrOffset, int nLedsIfOffset) {
+  int nOffset = (nLedsIfOffset > 0) ? nLedsOrOffset : 0;
+  int nLeds = (nLedsIfOffset > 0) ? nLedsIfOffset : nLedsOrOffset;
+
   pLed->setLeds(data + nOffset, nLeds);
+  pLed->init();
   FastLED.setMaxRefreshRate(pLed->getMaxRefreshRate(),true);
   return *pLed;
 }
@@ -54,15 +74,60 @@ void CFastLED::show(uint8_t scale) {
 
   CLEDController *pCur = CLEDController::head();
   while(pCur) {
-    uint8_t d = pCur->getDither();
-    if(m_nFPS < 100) { pCur->setDither(0); }
-    pCur->showLeds(scale);
-    pCur->setDither(d);
+    if(_show_dirty_only && !pCur->m_bDirty) {
+      pCur->skipShow();
+    } else {
+      // -- The power function leaves each power zone a brightness of its own
+      pCur->showLeds(m_pPowerFunc ? power_zone_brightness(pCur->getPowerZone()) : scale);
+      pCur->m_bDirty = false;
+    }
     pCur = pCur->next();
   }
   countFPS();
 }
 
+void CFastLED::showDirty(uint8_t scale) {
+  _show_dirty_only = true;
+  show(scale);
+  _show_dirty_only = false;
+}
+
+void CFastLED::showAsync(uint8_t scale) {
+  _show_async = true;
+  show(scale);
+  _show_async = false;
+}
+
+void CFastLED::reserve() {
+  CLEDController *pCur = CLEDController::head();
+  while(pCur) {
+    pCur->reserve();
+    pCur = pCur->next();
+  }
+}
+
+void CFastLED::waitForShow() {
+  CLEDController *pCur = CLEDController::head();
+  while(pCur) {
+    pCur->waitForShow();
+    pCur = pCur->next();
+  }
+}
+
+bool CFastLED::isShowing() {
+  CLEDController *pCur = CLEDController::head();
+  while(pCur) {
+    if(pCur->isShowing()) { return true; }
+    pCur = pCur->next();
+  }
+  return false;
+}
+
+void CFastLED::setShowDoneCallback(show_done_func func, void *arg) {
+  _show_done_arg = arg;
+  _show_done_func = func;
+}
+
 int CFastLED::count() {
   int x = 0;
   CLEDController *pCur = CLEDController::head();
@@ -96,10 +161,7 @@ void CFastLED::showColor(const struct CRGBW & color, uint8_t scale) {
 
   CLEDController *pCur = CLEDController::head();
   while(pCur) {
-    uint8_t d = pCur->getDither();
-    if(m_nFPS < 100) { pCur->setDither(0); }
-    pCur->showColor(color, scale);
-    pCur->setDither(d);
+    pCur->showColor(color, m_pPowerFunc ? power_zone_brightness(pCur->getPowerZone()) : scale);
     pCur = pCur->next();
   }
   countFPS();
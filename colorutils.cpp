@@ -16,6 +16,7 @@ void fill_solid( struct CRGBW * leds, int numToFill,
     for( int i = 0; i < numToFill; i++) {
         leds[i] = color;
     }
+    power_track_changed( leds, numToFill);
 }
 
 void fill_solid( struct CHSV * targetArray, int numToFill,
@@ -45,6 +46,7 @@ void fill_rainbow( struct CRGBW * pFirstLED, int numToFill,
         pFirstLED[i] = hsv;
         hsv.hue += deltahue;
     }
+    power_track_changed( pFirstLED, numToFill);
 }
 
 void fill_rainbow( struct CHSV * targetArray, int numToFill,
@@ -104,6 +106,7 @@ void fill_gradient_RGB( CRGBW* leds,
         g88 += gdelta87;
         b88 += bdelta87;
     }
+    power_track_changed( leds + startpos, endpos - startpos + 1);
 }
 
 #if 0
@@ -169,11 +172,57 @@ void fill_gradient_RGB( CRGBW* leds, uint16_t numLeds, const CRGBW& c1, const CR
 
 
 
+// The array scaling functions below work on a whole CRGBW at a time, as a
+// 32 bit word: two channels are scaled with each multiply, since a channel
+// times a scale of at most 256 fits in 16 bits.  They give the same results
+// as scaling one channel at a time with nscale8x3 / nscale8x3_video.
+// Arrays that are not on a 4 byte boundary are done one channel at a time.
+
+// x * m / 256 for each channel of x, m <= 256
+static inline uint32_t packed_scale8( uint32_t x, uint32_t m)
+{
+    return ((((x & 0x00FF00FF) * m) >> 8) & 0x00FF00FF) | ((((x >> 8) & 0x00FF00FF) * m) & 0xFF00FF00);
+}
+
+// 0x01 in every byte of x that is not zero
+static inline uint32_t packed_nonzero1( uint32_t x)
+{
+    return ((((x & 0x7F7F7F7F) + 0x7F7F7F7F) | x) & 0x80808080) >> 7;
+}
+
+static inline bool is_word_aligned( const CRGBW* leds)
+{
+    return (((uintptr_t)leds) & 3) == 0;
+}
+
 void nscale8_video( CRGBW* leds, uint16_t num_leds, uint8_t scale)
 {
-    for( uint16_t i = 0; i < num_leds; i++) {
+    // -- Nothing changes at 255, and everything goes to 0 at 0
+    if( scale == 255) return;
+    if( scale == 0) {
+        memset( (void*)leds, 0, num_leds * sizeof(CRGBW));
+        power_track_changed( leds, num_leds);
+        return;
+    }
+
+    uint16_t i = 0;
+    if( is_word_aligned( leds)) {
+        uint32_t* p = (uint32_t*)leds;
+        for( ; i + 4 <= num_leds; i += 4) {
+            uint32_t x0 = p[i], x1 = p[i+1], x2 = p[i+2], x3 = p[i+3];
+            p[i]   = packed_scale8( x0, scale) + packed_nonzero1( x0);
+            p[i+1] = packed_scale8( x1, scale) + packed_nonzero1( x1);
+            p[i+2] = packed_scale8( x2, scale) + packed_nonzero1( x2);
+            p[i+3] = packed_scale8( x3, scale) + packed_nonzero1( x3);
+        }
+        for( ; i < num_leds; i++) {
+            p[i] = packed_scale8( p[i], scale) + packed_nonzero1( p[i]);
+        }
+    }
+    for( ; i < num_leds; i++) {
         leds[i].nscale8_video( scale);
     }
+    power_track_changed( leds, num_leds);
 }
 
 void fade_video(CRGBW* leds, uint16_t num_leds, uint8_t fadeBy)
@@ -204,9 +253,32 @@ void nscale8_raw( CRGBW* leds, uint16_t num_leds, uint8_t scale)
 
 void nscale8( CRGBW* leds, uint16_t num_leds, uint8_t scale)
 {
-    for( uint16_t i = 0; i < num_leds; i++) {
+#if (FASTLED_SCALE8_FIXED == 1)
+    uint32_t m = (uint32_t)scale + 1;
+    // -- Nothing changes at 255
+    if( m == 256) return;
+#else
+    uint32_t m = scale;
+#endif
+
+    uint16_t i = 0;
+    if( is_word_aligned( leds)) {
+        uint32_t* p = (uint32_t*)leds;
+        for( ; i + 4 <= num_leds; i += 4) {
+            uint32_t x0 = p[i], x1 = p[i+1], x2 = p[i+2], x3 = p[i+3];
+            p[i]   = packed_scale8( x0, m);
+            p[i+1] = packed_scale8( x1, m);
+            p[i+2] = packed_scale8( x2, m);
+            p[i+3] = packed_scale8( x3, m);
+        }
+        for( ; i < num_leds; i++) {
+            p[i] = packed_scale8( p[i], m);
+        }
+    }
+    for( ; i < num_leds; i++) {
         leds[i].nscale8( scale);
     }
+    power_track_changed( leds, num_leds);
 }
 
 void fadeUsingColor( CRGBW* leds, uint16_t numLeds, const CRGBW& colormask)
@@ -223,6 +295,7 @@ void fadeUsingColor( CRGBW* leds, uint16_t numLeds, const CRGBW& colormask)
         leds[i].b = scale8                 ( leds[i].b, fb);
         leds[i].w = scale8                 ( leds[i].w, fw);
     }
+    power_track_changed( leds, numLeds);
 }
 
 
@@ -262,13 +335,55 @@ CRGBW& nblend( CRGBW& existing, const CRGBW& overlay, fract8 amountOfOverlay )
 
 
 
-void nblend( CRGBW* existing, CRGBW* overlay, uint16_t count, fract8 amountOfOverlay)
+// Blend two arrays into a third (which may be either of them), a whole CRGBW
+// at a time as with the scaling functions above: each channel's blend8 sum
+// fits in 16 bits, so two channels share a multiply.  The results are the
+// same as blend8 on each channel.
+static void blend_arrays( const CRGBW* src1, const CRGBW* src2, CRGBW* dest, uint16_t count, fract8 amountOfsrc2)
 {
-    for( uint16_t i = count; i; i--) {
-        nblend( *existing, *overlay, amountOfOverlay);
-        existing++;
-        overlay++;
+    // -- All of one or the other is just a copy
+    if( amountOfsrc2 == 0) {
+        if( dest != src1) memmove( (void*)dest, src1, count * sizeof(CRGBW));
+        return;
     }
+    if( amountOfsrc2 == 255) {
+        if( dest != src2) memmove( (void*)dest, src2, count * sizeof(CRGBW));
+        return;
+    }
+
+    uint16_t i = 0;
+    if( is_word_aligned( src1) && is_word_aligned( src2) && is_word_aligned( dest)) {
+        const uint32_t* p1 = (const uint32_t*)src1;
+        const uint32_t* p2 = (const uint32_t*)src2;
+        uint32_t* out = (uint32_t*)dest;
+#if (FASTLED_SCALE8_FIXED == 1)
+        uint32_t m1 = 256 - amountOfsrc2, m2 = (uint32_t)amountOfsrc2 + 1;
+#else
+        uint32_t m1 = 255 - amountOfsrc2, m2 = amountOfsrc2;
+#endif
+#if (FASTLED_BLEND_FIXED == 1)
+        for( ; i < count; i++) {
+            uint32_t x = p1[i], y = p2[i];
+            out[i] = ((((x & 0x00FF00FF) * m1 + (y & 0x00FF00FF) * m2) >> 8) & 0x00FF00FF)
+                   | ((((x >> 8) & 0x00FF00FF) * m1 + ((y >> 8) & 0x00FF00FF) * m2) & 0xFF00FF00);
+        }
+#else
+        // -- scale8 each side on its own and add them, wrapping, as blend8 does
+        for( ; i < count; i++) {
+            uint32_t a = packed_scale8( p1[i], m1), b = packed_scale8( p2[i], m2);
+            out[i] = ((a & 0x7F7F7F7F) + (b & 0x7F7F7F7F)) ^ ((a ^ b) & 0x80808080);
+        }
+#endif
+    }
+    for( ; i < count; i++) {
+        dest[i] = blend( src1[i], src2[i], amountOfsrc2);
+    }
+}
+
+void nblend( CRGBW* existing, CRGBW* overlay, uint16_t count, fract8 amountOfOverlay)
+{
+    blend_arrays( existing, overlay, existing, count, amountOfOverlay);
+    power_track_changed( existing, count);
 }
 
 CRGBW blend( const CRGBW& p1, const CRGBW& p2, fract8 amountOfP2 )
@@ -280,9 +395,8 @@ CRGBW blend( const CRGBW& p1, const CRGBW& p2, fract8 amountOfP2 )
 
 CRGBW* blend( const CRGBW* src1, const CRGBW* src2, CRGBW* dest, uint16_t count, fract8 amountOfsrc2 )
 {
-    for( uint16_t i = 0; i < count; i++) {
-        dest[i] = blend(src1[i], src2[i], amountOfsrc2);
-    }
+    blend_arrays( src1, src2, dest, count, amountOfsrc2);
+    power_track_changed( dest, count);
     return dest;
 }
 
@@ -398,44 +512,186 @@ void blur1d( CRGBW* leds, uint16_t numLeds, fract8 blur_amount)
         leds[i] = cur;
         carryover = part;
     }
+    power_track_changed( leds, numLeds);
 }
 
-void blur2d( CRGBW* leds, uint8_t width, uint8_t height, fract8 blur_amount)
+// The application's XY function, as a map for the 2D functions below.  Matrices
+// too big for XY are taken to be in plain rows.
+struct XYFunctionMap {
+    uint16_t mWidth;
+    uint16_t mHeight;
+    XYFunctionMap( uint16_t width, uint16_t height) : mWidth(width), mHeight(height) {}
+    inline uint32_t mapXY( uint16_t x, uint16_t y) const {
+        if( mWidth <= 256 && mHeight <= 256) {
+            return XY( x, y);
+        }
+        return (uint32_t)y * mWidth + x;
+    }
+};
+
+// qadd8 on each channel of a packed pixel
+static inline uint32_t packed_qadd8( uint32_t x, uint32_t y)
 {
-    blurRows(leds, width, height, blur_amount);
-    blurColumns(leds, width, height, blur_amount);
+    uint32_t sum = ((x & 0x7F7F7F7F) + (y & 0x7F7F7F7F)) ^ ((x ^ y) & 0x80808080);
+    uint32_t carry = ((x & y) | ((x | y) & ~sum)) & 0x80808080;
+    return sum | ((carry >> 7) * 0xFF);
 }
 
-// blurRows: perform a blur1d on every row of a rectangular matrix
-void blurRows( CRGBW* leds, uint8_t width, uint8_t height, fract8 blur_amount)
+// blur1d on a row of packed pixels, in place
+static void blur_row( uint32_t* row, uint16_t width, uint32_t keep, uint32_t seep)
 {
-    for( uint8_t row = 0; row < height; row++) {
-        CRGBW* rowbase = leds + (row * width);
-        blur1d( rowbase, width, blur_amount);
+    uint32_t carryover = 0;
+    for( uint16_t i = 0; i < width; i++) {
+        uint32_t cur = row[i];
+        uint32_t part = packed_scale8( cur, seep);
+        cur = packed_qadd8( packed_scale8( cur, keep), carryover);
+        if( i) row[i-1] = packed_qadd8( row[i-1], part);
+        row[i] = cur;
+        carryover = part;
     }
 }
 
-// blurColumns: perform a blur1d on each column of a rectangular matrix
-void blurColumns(CRGBW* leds, uint8_t width, uint8_t height, fract8 blur_amount)
+// Three rows of packed pixels for blur2d, kept from one call to the next
+static uint32_t* gBlurRing = NULL;
+static uint32_t  gBlurRingSize = 0;
+
+// blurRows through a map
+template<class MAP> static void blur_rows( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount, const MAP& map)
 {
-    // blur columns
     uint8_t keep = 255 - blur_amount;
     uint8_t seep = blur_amount >> 1;
-    for( uint8_t col = 0; col < width; col++) {
+    for( uint16_t row = 0; row < height; row++) {
         CRGBW carryover = CRGBW::Black;
-        for( uint8_t i = 0; i < height; i++) {
-            CRGBW cur = leds[XY(col,i)];
+        for( uint16_t i = 0; i < width; i++) {
+            CRGBW cur = leds[map.mapXY(i,row)];
             CRGBW part = cur;
             part.nscale8( seep);
             cur.nscale8( keep);
             cur += carryover;
-            if( i) leds[XY(col,i-1)] += part;
-            leds[XY(col,i)] = cur;
+            if( i) leds[map.mapXY(i-1,row)] += part;
+            leds[map.mapXY(i,row)] = cur;
             carryover = part;
         }
     }
 }
 
+// blurColumns through a map
+template<class MAP> static void blur_columns( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount, const MAP& map)
+{
+    uint8_t keep = 255 - blur_amount;
+    uint8_t seep = blur_amount >> 1;
+    for( uint16_t col = 0; col < width; col++) {
+        CRGBW carryover = CRGBW::Black;
+        for( uint16_t i = 0; i < height; i++) {
+            CRGBW cur = leds[map.mapXY(col,i)];
+            CRGBW part = cur;
+            part.nscale8( seep);
+            cur.nscale8( keep);
+            cur += carryover;
+            if( i) leds[map.mapXY(col,i-1)] += part;
+            leds[map.mapXY(col,i)] = cur;
+            carryover = part;
+        }
+    }
+}
+
+// blur2d keeps the last three rows, blurred along the row, in a ring.  Once
+// the row below has been read in, a row has all it needs to be blurred down
+// its columns, and goes back to the leds.  Each led is read and written once,
+// and the map is used only for those reads and writes.  When the map keeps
+// each row together (as plain and serpentine layouts do), the result is the
+// same as blurring the rows and then the columns.
+template<class MAP> static void blur_2d( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount, const MAP& map)
+{
+    if( !width || !height) return;
+
+    uint32_t ringSize = 3 * (uint32_t)width;
+    if( ringSize > gBlurRingSize) {
+        free( gBlurRing);
+        gBlurRing = (uint32_t*)malloc( ringSize * sizeof(uint32_t));
+        gBlurRingSize = gBlurRing ? ringSize : 0;
+        if( !gBlurRing) {
+            // -- No room: blur one way and then the other
+            blur_rows( leds, width, height, blur_amount, map);
+            blur_columns( leds, width, height, blur_amount, map);
+            return;
+        }
+    }
+
+#if (FASTLED_SCALE8_FIXED == 1)
+    uint32_t keep = 256 - blur_amount;
+    uint32_t seep = (blur_amount >> 1) + 1;
+#else
+    uint32_t keep = 255 - blur_amount;
+    uint32_t seep = blur_amount >> 1;
+#endif
+
+    for( uint16_t y = 0; y <= height; y++) {
+        // -- Read in and blur row y, over the row from three rows back
+        if( y < height) {
+            uint32_t* row = gBlurRing + (y % 3) * width;
+            for( uint16_t x = 0; x < width; x++) {
+                CRGBW led = leds[map.mapXY( x, y)];
+                row[x] = led.r | (led.g << 8) | (led.b << 16) | ((uint32_t)led.w << 24);
+            }
+            blur_row( row, width, keep, seep);
+        }
+        if( y == 0) continue;
+
+        // -- Then row y-1, which now has the rows above and below it
+        uint16_t out = y - 1;
+        const uint32_t* above = out ? gBlurRing + ((out - 1) % 3) * width : NULL;
+        const uint32_t* cur = gBlurRing + (out % 3) * width;
+        const uint32_t* below = (y < height) ? gBlurRing + (y % 3) * width : NULL;
+        for( uint16_t x = 0; x < width; x++) {
+            uint32_t v = packed_scale8( cur[x], keep);
+            if( above) v = packed_qadd8( v, packed_scale8( above[x], seep));
+            if( below) v = packed_qadd8( v, packed_scale8( below[x], seep));
+            leds[map.mapXY( x, out)] = CRGBW( v, v >> 8, v >> 16, v >> 24);
+        }
+    }
+}
+
+void blur2d( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount)
+{
+    blur_2d( leds, width, height, blur_amount, XYFunctionMap( width, height));
+    power_track_changed( leds, (uint32_t)width * height);
+}
+
+void blur2d( CRGBW* leds, const CXYMap& map, fract8 blur_amount)
+{
+    blur_2d( leds, map.width(), map.height(), blur_amount, map);
+    power_track_changed( leds, map.numLeds());
+}
+
+// blurRows: perform a blur1d on every row of a rectangular matrix
+void blurRows( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount)
+{
+    for( uint16_t row = 0; row < height; row++) {
+        CRGBW* rowbase = leds + ((uint32_t)row * width);
+        blur1d( rowbase, width, blur_amount);
+    }
+}
+
+void blurRows( CRGBW* leds, const CXYMap& map, fract8 blur_amount)
+{
+    blur_rows( leds, map.width(), map.height(), blur_amount, map);
+    power_track_changed( leds, map.numLeds());
+}
+
+// blurColumns: perform a blur1d on each column of a rectangular matrix
+void blurColumns(CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount)
+{
+    blur_columns( leds, width, height, blur_amount, XYFunctionMap( width, height));
+    power_track_changed( leds, (uint32_t)width * height);
+}
+
+void blurColumns(CRGBW* leds, const CXYMap& map, fract8 blur_amount)
+{
+    blur_columns( leds, map.width(), map.height(), blur_amount, map);
+    power_track_changed( leds, map.numLeds());
+}
+
 
 
 // CRGBW HeatColor( uint8_t temperature)
@@ -1241,6 +1497,7 @@ void napplyGamma_video( CRGBW* rgbarray, uint16_t count, float gamma)
     for( uint16_t i = 0; i < count; i++) {
         rgbarray[i] = applyGamma_video( rgbarray[i], gamma);
     }
+    power_track_changed( rgbarray, count);
 }
 
 void napplyGamma_video( CRGBW* rgbarray, uint16_t count, float gammaR, float gammaG, float gammaB)
@@ -1248,6 +1505,7 @@ void napplyGamma_video( CRGBW* rgbarray, uint16_t count, float gammaR, float gam
     for( uint16_t i = 0; i < count; i++) {
         rgbarray[i] = applyGamma_video( rgbarray[i], gammaR, gammaG, gammaB);
     }
+    power_track_changed( rgbarray, count);
 }
 
 
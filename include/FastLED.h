@@ -55,6 +55,7 @@
 #include "lib8tion.h"
 #include "pixeltypes.h"
 #include "hsv2rgb.h"
+#include "xymap.h"
 #include "colorutils.h"
 #include "pixelset.h"
 #include "colorpalettes.h"
@@ -191,6 +192,9 @@ public:
 	/// @returns a reference to the added controller
 	static CLEDController &addLeds(CLEDController *pLed, struct CRGBW *data, int nLedsOrOffset, int nLedsIfOffset = 0);
 
+	/// Add a CLEDController instance to the world, with 16 bit led data.  The arguments are the same as above.
+	static CLEDController &addLeds(CLEDController *pLed, struct CRGBW16 *data, int nLedsOrOffset, int nLedsIfOffset = 0);
+
 	/// @name Adding SPI based controllers
   //@{
 	/// Add an SPI based  CLEDController instance to the world.
@@ -300,6 +304,20 @@ public:
 		return addLeds(&c, data, nLedsOrOffset, nLedsIfOffset);
 	}
 
+	/// Add a clockless based CLEDController instance with 16 bit led data, which is dithered down to
+	/// the 8 bits that the chipset takes.  The arguments are the same as above.
+	template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+	static CLEDController &addLeds(struct CRGBW16 *data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+		static CHIPSET<DATA_PIN, RGB_ORDER> c;
+		return addLeds(&c, data, nLedsOrOffset, nLedsIfOffset);
+	}
+
+	template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN>
+	static CLEDController &addLeds(struct CRGBW16 *data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+		static CHIPSET<DATA_PIN, RGB> c;
+		return addLeds(&c, data, nLedsOrOffset, nLedsIfOffset);
+	}
+
 	template<template<uint8_t DATA_PIN> class CHIPSET, uint8_t DATA_PIN>
 	static CLEDController &addLeds(struct CRGBW *data, int nLedsOrOffset, int nLedsIfOffset = 0) {
 		static CHIPSET<DATA_PIN> c;
@@ -475,6 +493,26 @@ public:
 	/// @param milliwatts - the max power draw desired, in milliwatts
 	inline void setMaxPowerInMilliWatts(uint32_t milliwatts) { m_pPowerFunc = &calculate_max_brightness_for_power_mW; m_nPowerData = milliwatts; }
 
+	/// Set the maximum power to be used by the controllers in one power zone (see CLEDController::setPowerZone),
+	/// given in volts and milliamps
+	/// @param zone - the power zone, from 0 to FASTLED_POWER_ZONES-1
+	/// @param volts - how many volts the leds are being driven at (usually 5)
+	/// @param milliamps - the maximum milliamps of power draw you want, or 0 for no limit
+	inline void setZoneMaxPowerInVoltsAndMilliamps(uint8_t zone, uint8_t volts, uint32_t milliamps) { setZoneMaxPowerInMilliWatts(zone, volts * milliamps); }
+
+	/// Set the maximum power to be used by the controllers in one power zone, given in milliwatts
+	/// @param zone - the power zone, from 0 to FASTLED_POWER_ZONES-1
+	/// @param milliwatts - the max power draw desired, in milliwatts, or 0 for no limit
+	inline void setZoneMaxPowerInMilliWatts(uint8_t zone, uint32_t milliwatts) { m_pPowerFunc = &calculate_max_brightness_for_power_mW; set_zone_max_power_in_milliwatts(zone, milliwatts); }
+
+	/// Smooth out the power limiting over time, rather than setting the brightness for each frame on its own
+	/// (see power_mgt.h).  With all arguments 0 the governor is turned off.
+	/// @param window_ms - the time over which the power draw is averaged
+	/// @param attack_ms - the time the brightness takes to come down all the way
+	/// @param release_ms - the time the brightness takes to go back up all the way
+	/// @param max_temp_C - the chip temperature above which the limits are lowered, or 0 to ignore it
+	inline void setPowerGovernor(uint16_t window_ms, uint16_t attack_ms, uint16_t release_ms, uint8_t max_temp_C = 0) { m_pPowerFunc = &calculate_max_brightness_for_power_mW; set_power_governor(window_ms, attack_ms, release_ms, max_temp_C); }
+
 	/// Update all our controllers with the current led colors, using the passed in brightness
 	/// @param scale temporarily override the scale
 	void show(uint8_t scale);
@@ -482,6 +520,40 @@ public:
 	/// Update all our controllers with the current led colors
 	void show() { show(m_Scale); }
 
+	/// Update all our controllers with the current led colors, using the passed in brightness, without
+	/// waiting for controllers that send in the background (e.g. the ESP32 RMT driver) to finish.  The
+	/// next call to show or showAsync waits for this frame before touching the led data.
+	/// @param scale temporarily override the scale
+	void showAsync(uint8_t scale);
+
+	/// Update all our controllers with the current led colors, without waiting for them to finish
+	void showAsync() { showAsync(m_Scale); }
+
+	/// Update only the controllers whose leds have been marked as changed with markDirty, using the
+	/// passed in brightness.  The other strips keep showing what they were last sent.
+	/// @param scale temporarily override the scale
+	void showDirty(uint8_t scale);
+
+	/// Update only the controllers whose leds have been marked as changed
+	void showDirty() { showDirty(m_Scale); }
+
+	/// Allocate the output buffers of all controllers now, so that show does not need the heap.  Call it
+	/// after adding all of the leds; otherwise the buffers are allocated by the first call to show.
+	void reserve();
+
+	/// Wait until the last frame started with showAsync has been completely sent
+	void waitForShow();
+
+	/// Is a frame started with showAsync still being sent?
+	/// @returns true if any controller is still sending in the background
+	bool isShowing();
+
+	/// Set a function to be called whenever a frame has been completely sent.  It is called
+	/// from interrupt context, so it must be short and must not block.
+	/// @param func the function to call, or NULL for none
+	/// @param arg an argument passed through to func
+	void setShowDoneCallback(show_done_func func, void *arg = NULL);
+
 	/// clear the leds, wiping the local array of data, optionally black out the leds as well
 	/// @param writeData whether or not to write out to the leds as well
 	void clear(bool writeData = false);
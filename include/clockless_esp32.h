@@ -33,6 +33,14 @@
  * send the data for 8 controllers simultaneously, but 16 controllers
  * would take approximately twice as much time.
  *
+ * When there are more controllers than channels, the order in which
+ * they are started matters: one long strip started last would keep
+ * the whole frame waiting. So each frame, the controllers are started
+ * longest first (by number of bytes), which keeps the total time close
+ * to the best possible. The timing of the last frame is available
+ * from rmtFrameStats(): the total wire time, the time channels sat
+ * idle, and how long each controller waited for a channel.
+ *
  * There is a #define that allows a program to control the total
  * number of channels that the driver is allowed to use. It defaults
  * to 8 -- use all the channels. Setting it to 1, for example, results
@@ -40,6 +48,94 @@
  *
  *     #define FASTLED_RMT_MAX_CHANNELS 1
  *
+ * ASYNCHRONOUS SHOW
+ *
+ * Normally the last call to showPixels waits until every channel has
+ * finished sending. FastLED.showAsync() skips that wait, so that the
+ * program can compute the next frame while this one is being sent.
+ * The next show (or FastLED.waitForShow()) waits for the previous
+ * frame before touching the pixel buffers. An optional callback set
+ * with FastLED.setShowDoneCallback() is called from the interrupt
+ * handler when a frame has been completely sent.
+ *
+ * PARTIAL UPDATES
+ *
+ * FastLED.showDirty() only sends the controllers that have been
+ * marked as changed with markDirty(). The others are left out of the
+ * frame altogether: they take no channel, the frame does not wait for
+ * them, and their strips keep showing what they were last sent.
+ *
+ * DOUBLE BUFFERING
+ *
+ * Each controller keeps a copy of its scaled, dithered and reordered
+ * pixel bytes for the interrupt handler to send. By default there is
+ * one copy, so the next frame cannot be prepared until the previous
+ * one is sent. With double buffering each controller has two, and the
+ * next frame is prepared in one while the other is still on the wire;
+ * they are swapped when the frame is started. Together with
+ * FastLED.showAsync() this overlaps almost all of show() with output:
+ *
+ *     #define FASTLED_RMT_DOUBLE_BUFFER 1
+ *
+ * TRANSMIT TASK
+ *
+ * The RMT interrupt handler runs on the core that allocated it, which
+ * is normally the core that calls FastLED.show(). In the pipelined
+ * mode, the driver starts a FreeRTOS task pinned to the other core.
+ * That task owns the RMT channels and their interrupt; show() only
+ * prepares the pixel data and hands the finished frame to it, through
+ * a lock-free single-producer/single-consumer queue. The queue slots
+ * are the two staging buffers, so this mode implies double buffering:
+ *
+ *     #define FASTLED_RMT_TX_TASK 1
+ *
+ * The task runs on core FASTLED_RMT_TX_CORE (by default, whichever
+ * core is not running the first call to show()) at priority
+ * FASTLED_RMT_TX_PRIORITY.
+ *
+ * BUFFER MEMORY
+ *
+ * The driver's buffers for all controllers come from one block of
+ * memory, allocated when the first frame is shown and sized from the
+ * leds attached to each controller. After that show() does not use
+ * the heap, unless a controller is added or a strip grows: then the
+ * block is carved up again, and grown if needed. To allocate it
+ * earlier (for example, before the heap gets fragmented), call
+ * FastLED.reserve() after adding the leds. If the block cannot be
+ * grown, the controllers that no longer fit get buffers of their own,
+ * and if even that fails, an error is logged and their frames are cut
+ * short.
+ *
+ * When an RGBW strip takes its bytes in the same order as CRGBW, and
+ * the frame needs no brightness, correction or dithering, a normal
+ * (synchronous) show sends the leds directly, without copying them.
+ *
+ * MEMORY BLOCKS
+ *
+ * Each RMT channel normally owns one 64-pulse block of RMT memory,
+ * which holds just 8 bytes of pixel data, so a channel interrupts
+ * every 4 bytes to be refilled. If fewer channels are needed, a
+ * channel can borrow the blocks of the channels after it. With N
+ * blocks per channel only 8/N channels are available (channels 0,
+ * N, 2N, ...), but each one interrupts N times less often, which also
+ * makes the output much more tolerant of interrupt latency (for
+ * example, from WiFi). Valid values are 1, 2, 4 and 8:
+ *
+ *     #define FASTLED_RMT_MEM_BLOCKS 4
+ *
+ * UNDERRUNS
+ *
+ * If the interrupt handler is held up (for example, by WiFi) for
+ * longer than it takes to send half the buffer, the RMT runs into
+ * the half that has not been refilled yet and sends stale data, and
+ * the strip shows garbage. The driver knows how long each half takes
+ * to send, so it can tell when a refill comes too late. It then stops
+ * that channel and sends the controller's data again from the start,
+ * after a latch, up to FASTLED_INTERRUPT_RETRY_COUNT times per frame.
+ * The number of underruns and retries on each RMT channel since
+ * startup is available from rmtChannelCounters(). (This only applies
+ * to our own driver, not FASTLED_RMT_BUILTIN_DRIVER.)
+ *
  * OTHER RMT APPLICATIONS
  *
  * The default FastLED driver takes over control of the RMT interrupt
@@ -51,12 +147,12 @@
  *
  *      #define FASTLED_RMT_BUILTIN_DRIVER 1
  *
- * There may be a performance penalty for using this mode. We need to
- * compute the RMT signal for the entire LED strip ahead of time,
- * rather than overlapping it with communication. We also need a large
- * buffer to hold the signal specification. Each bit of pixel data is
- * represented by a 32-bit pulse specification, so it is a 32X blow-up
- * in memory use.
+ * In this mode the pixel bytes are handed to the core driver with
+ * rmt_write_sample(), together with a translator function (registered
+ * with rmt_translator_init()) that the driver calls from its own
+ * interrupt handler to turn the bytes into RMT pulses as it goes. So
+ * it needs no more memory than our own driver, instead of a 32-bit
+ * pulse specification for every bit of pixel data.
  *
  *
  * Based on public domain code created 19 Nov 2016 by Chris Osborn <fozztexx@fozztexx.com>
@@ -105,17 +201,28 @@ extern "C" {
 }
 #endif
 
+#ifndef FASTLED_RMT_HW_OVERRIDE
 __attribute__ ((always_inline)) inline static uint32_t __clock_cycles() {
   uint32_t cyc;
   __asm__ __volatile__ ("rsr %0,ccount":"=a" (cyc));
   return cyc;
 }
+#endif
 
 #define FASTLED_HAS_CLOCKLESS 1
 
+// -- Number of RMT memory blocks (64 pulses each) given to each channel
+#ifndef FASTLED_RMT_MEM_BLOCKS
+#define FASTLED_RMT_MEM_BLOCKS 1
+#endif
+
+#if (FASTLED_RMT_MEM_BLOCKS != 1) && (FASTLED_RMT_MEM_BLOCKS != 2) && (FASTLED_RMT_MEM_BLOCKS != 4) && (FASTLED_RMT_MEM_BLOCKS != 8)
+#error "FASTLED_RMT_MEM_BLOCKS must be 1, 2, 4 or 8"
+#endif
+
 // -- Configuration constants
 #define DIVIDER             2 /* 4, 8 still seem to work, but timings become marginal */
-#define MAX_PULSES         32 /* A channel has a 64 "pulse" buffer - we use half per pass */
+#define MAX_PULSES         (32 * FASTLED_RMT_MEM_BLOCKS) /* A channel has a 64 "pulse" buffer per block - we use half per pass */
 
 // -- Convert ESP32 cycles back into nanoseconds
 #define ESPCLKS_TO_NS(_CLKS) (((long)(_CLKS) * 1000L) / F_CPU_MHZ)
@@ -130,14 +237,51 @@ __attribute__ ((always_inline)) inline static uint32_t __clock_cycles() {
 // -- Convert ESP32 cycles to RMT cycles
 #define TO_RMT_CYCLES(_CLKS) NS_TO_CYCLES(ESPCLKS_TO_NS(_CLKS))    
 
+// -- Convert RMT cycles to ESP32 cycles
+#define RMT_TO_ESPCLKS(_CYCLES) (((long)(_CYCLES) * DIVIDER * F_CPU_MHZ) / (F_CPU_RMT / 1000000L))
+
 // -- Number of cycles to signal the strip to latch
 #define RMT_RESET_DURATION NS_TO_CYCLES(50000)
 
+// -- Duration of each half of an item in a half buffer of nothing but
+//    low output, long enough to latch the strip
+#define RMT_LATCH_DURATION ((RMT_RESET_DURATION / (2 * MAX_PULSES)) + 1)
+
 // -- Core or custom driver
 #ifndef FASTLED_RMT_BUILTIN_DRIVER
 #define FASTLED_RMT_BUILTIN_DRIVER false
 #endif
 
+// -- Run the RMT from a task on the other core
+#ifndef FASTLED_RMT_TX_TASK
+#define FASTLED_RMT_TX_TASK 0
+#endif
+
+// -- Core and priority of the transmit task; -1 means the core that
+//    the first call to show() is not running on
+#ifndef FASTLED_RMT_TX_CORE
+#define FASTLED_RMT_TX_CORE -1
+#endif
+
+#ifndef FASTLED_RMT_TX_PRIORITY
+#define FASTLED_RMT_TX_PRIORITY (configMAX_PRIORITIES - 1)
+#endif
+
+#ifndef FASTLED_RMT_TX_STACK
+#define FASTLED_RMT_TX_STACK 2048
+#endif
+
+// -- Prepare the next frame while the previous one is being sent
+#ifndef FASTLED_RMT_DOUBLE_BUFFER
+#define FASTLED_RMT_DOUBLE_BUFFER FASTLED_RMT_TX_TASK
+#endif
+
+#if FASTLED_RMT_TX_TASK && ! FASTLED_RMT_DOUBLE_BUFFER
+#error "FASTLED_RMT_TX_TASK needs FASTLED_RMT_DOUBLE_BUFFER"
+#endif
+
+#define FASTLED_RMT_STAGE_AHEAD FASTLED_RMT_DOUBLE_BUFFER
+
 // -- Max number of controllers we can support
 #ifndef FASTLED_RMT_MAX_CONTROLLERS
 #define FASTLED_RMT_MAX_CONTROLLERS 32
@@ -149,34 +293,203 @@ __attribute__ ((always_inline)) inline static uint32_t __clock_cycles() {
 #define FASTLED_RMT_MAX_CHANNELS 8
 #endif
 
+// -- Number of channels we can actually run at once, given how many
+//    memory blocks each one takes. Channel i of these is RMT channel
+//    i * FASTLED_RMT_MEM_BLOCKS.
+#if (FASTLED_RMT_MAX_CHANNELS * FASTLED_RMT_MEM_BLOCKS) > 8
+#define FASTLED_RMT_NUM_CHANNELS (8 / FASTLED_RMT_MEM_BLOCKS)
+#else
+#define FASTLED_RMT_NUM_CHANNELS FASTLED_RMT_MAX_CHANNELS
+#endif
+
+#define RMT_HW_CHANNEL(i) ((i) * FASTLED_RMT_MEM_BLOCKS)
+
+// -- Direct access to the RMT registers and memory. Everything else
+//    goes through the IDF rmt_*, FreeRTOS and esp_intr_* calls. A
+//    build that stands in for the hardware (for example, to run the
+//    driver against a model of the RMT on a host) defines
+//    FASTLED_RMT_HW_OVERRIDE and supplies these, together with
+//    __clock_cycles(). RMT_TX_STOP and RMT_TX_RESTART are for the
+//    interrupt handler, which cannot call the IDF functions (they are
+//    not in IRAM): they stop a channel, and start it again from the
+//    beginning of its memory.
+#ifndef FASTLED_RMT_HW_OVERRIDE
+#define RMT_INTR_STATUS()       (RMT.int_st.val)
+#define RMT_INTR_CLEAR(_BITS)   (RMT.int_clr.val = (_BITS))
+#define RMT_CHANNEL_MEM(_CH)    (& RMTMEM.chan[(_CH)].data32[0].val)
+#define RMT_TX_STOP(_CH)        (RMT.conf_ch[(_CH)].conf1.tx_start = 0)
+#define RMT_TX_RESTART(_CH)     do { RMT.conf_ch[(_CH)].conf1.mem_rd_rst = 1; \
+                                     RMT.conf_ch[(_CH)].conf1.mem_rd_rst = 0; \
+                                     RMT.conf_ch[(_CH)].conf1.tx_start = 1; } while (0)
+#endif
+
 // -- Array of all controllers
 static CLEDController * gControllers[FASTLED_RMT_MAX_CONTROLLERS];
 
 // -- Current set of active controllers, indexed by the RMT
 //    channel assigned to them.
-static CLEDController * gOnChannel[FASTLED_RMT_MAX_CHANNELS];
+static CLEDController * gOnChannel[RMT_CHANNEL_MAX];
 
 static int gNumControllers = 0;
+
+// -- Number of controllers with data to send this frame. The others
+//    were left out by FastLED.showDirty().
+static int gNumActive = 0;
 static int gNumStarted = 0;
-static int gNumDone = 0;
-static int gNext = 0;
+static volatile int gNumDone = 0;
+static volatile int gNext = 0;
+
+// -- Order in which the controllers are started this frame, as
+//    indexes into gControllers: longest first
+static int gOrder[FASTLED_RMT_MAX_CONTROLLERS];
+
+// -- Statistics for the last frame, in microseconds. They are filled
+//    in as the frame is sent, so they are only complete once it is done.
+struct RMTFrameStats {
+    uint32_t wireTime;      // from the start of the frame until the last channel finished
+    uint32_t idleTime;      // total time that channels in use sat idle during the frame
+    int      numControllers;
+
+    // -- Per controller, in the order they were added
+    uint32_t queueDelay[FASTLED_RMT_MAX_CONTROLLERS];   // time waiting for a channel
+    uint32_t sendTime[FASTLED_RMT_MAX_CONTROLLERS];     // time on the wire
+};
+
+static RMTFrameStats gStats;
+
+// -- One block of memory for every controller's buffers
+static uint8_t * gArena = NULL;
+static int gArenaSize = 0;
+static uint32_t gFrameStart = 0;
+static uint32_t gBusyTime = 0;
+
+static inline const RMTFrameStats & rmtFrameStats() { return gStats; }
+
+// -- Underruns detected and frames resent on each RMT channel, since
+//    startup
+struct RMTChannelCounters {
+    uint32_t underruns[RMT_CHANNEL_MAX];
+    uint32_t retries[RMT_CHANNEL_MAX];
+};
+
+static RMTChannelCounters gCounters;
+
+static inline const RMTChannelCounters & rmtChannelCounters() { return gCounters; }
+
+#ifdef FASTLED_DEBUG_COUNT_FRAME_RETRIES
+extern uint32_t _frame_cnt;
+extern uint32_t _retry_cnt;
+#endif
+
+// -- True from the time a frame is started until its last channel
+//    is done. Cleared by the interrupt handler.
+static volatile bool gShowing = false;
+
+// -- Asynchronous show state, owned by CFastLED (see FastLED.cpp)
+extern bool _show_async;
+extern show_done_func _show_done_func;
+extern void * _show_done_arg;
 
 static intr_handle_t gRMT_intr_handle = NULL;
 
+// -- The core the interrupt handler runs on. Each core has its own
+//    cycle counter, so times compared in the handler must come from
+//    this core.
+static int gRMT_intr_core = 0;
+
 // -- Global semaphore for the whole show process
 //    Semaphore is not given until all data has been sent
 static xSemaphoreHandle gTX_sem = NULL;
 
 static bool gInitialized = false;
 
+// -- Staging buffer that the next frame is copied into
+static int gBack = 0;
+
+// -- Frame queue for the transmit task. Frame n is held in staging
+//    buffer n & 1. gTxHead counts frames handed over by show() and is
+//    only written by it; gTxTail counts frames completely sent and is
+//    only written by the transmit task. The queue holds at most two
+//    frames: one being sent and one waiting.
+static TaskHandle_t gTxTask = NULL;
+static volatile uint32_t gTxHead = 0;
+static volatile uint32_t gTxTail = 0;
+
+// -- Given by the transmit task each time it finishes a frame
+static xSemaphoreHandle gTxDone_sem = NULL;
+
+// -- Pulse lookup table
+//    Maps each of the 256 byte values to the eight RMT items that
+//    encode it, MSB first. There is one table per timing profile
+//    (T1, T2, T3), shared by every controller that uses that
+//    profile. It is filled in once, by the first controller's init(),
+//    so that refilling the RMT buffer is a straight copy of words.
+template <int T1, int T2, int T3>
+class ClocklessRMTPulseTable
+{
+public:
+    static uint32_t mPulses[256 * 8];
+    static bool     mBuilt;
+
+    static void build(uint32_t zero_val, uint32_t one_val)
+    {
+        if (mBuilt) return;
+
+        for (int byteval = 0; byteval < 256; byteval++) {
+            uint32_t * pulses = mPulses + (byteval << 3);
+            for (int j = 0; j < 8; j++) {
+                pulses[j] = (byteval & (0x80 >> j)) ? one_val : zero_val;
+            }
+        }
+
+        mBuilt = true;
+    }
+
+    // -- Translator for the built-in RMT driver
+    //    Called from the driver's interrupt handler to convert as many
+    //    whole bytes as fit into wanted_num items. The last item of the
+    //    frame is stretched to latch the strip.
+    static void IRAM_ATTR translate(const void * src, rmt_item32_t * dest, size_t src_size,
+                                    size_t wanted_num, size_t * translated_size, size_t * item_num)
+    {
+        if (src == NULL || dest == NULL) {
+            *translated_size = 0;
+            *item_num = 0;
+            return;
+        }
+
+        const uint8_t * psrc = (const uint8_t *) src;
+        size_t size = 0;
+        size_t num = 0;
+        while (size < src_size && num + 8 <= wanted_num) {
+            const uint32_t * pulses = mPulses + (psrc[size] << 3);
+            for (int j = 0; j < 8; j++) {
+                dest[num + j].val = pulses[j];
+            }
+            num += 8;
+            size++;
+        }
+
+        if (size == src_size && num > 0)
+            dest[num - 1].duration1 = RMT_RESET_DURATION;
+
+        *translated_size = size;
+        *item_num = num;
+    }
+};
+
+template <int T1, int T2, int T3> uint32_t ClocklessRMTPulseTable<T1, T2, T3>::mPulses[256 * 8];
+template <int T1, int T2, int T3> bool ClocklessRMTPulseTable<T1, T2, T3>::mBuilt = false;
+
 template <int DATA_PIN, int numBytes, int T1, int T2, int T3, EOrder RGB_ORDER = RGB, int XTRA0 = 0, bool FLIP = false, int WAIT_TIME = 5>
 class ClocklessController : public CPixelLEDController<RGB_ORDER>
 {
     // -- RMT has 8 channels, numbered 0 to 7
     rmt_channel_t  mRMT_channel;
 
-    // -- How many bytes (rgb or rgbw)
-    // int nBytes;
+    // -- How many bytes (rgb or rgbw). The copy loop uses the numBytes
+    //    template parameter; this copy is for the static functions that
+    //    work on every controller, whatever its instantiation.
     int    nBytes = numBytes;
 
     // -- Store the GPIO pin
@@ -189,16 +502,50 @@ class ClocklessController : public CPixelLEDController<RGB_ORDER>
     rmt_item32_t   mZero;
     rmt_item32_t   mOne;
 
+    // -- Byte to pulse table for this timing profile, and the
+    //    translator that uses it for the built-in driver
+    const uint32_t * mPulseTable;
+    sample_to_rmt_t  mTranslator;
+
+    // -- Position in gControllers, and when this frame was started
+    int            mIndex;
+    uint32_t       mStartTime;
+
     // -- State information for keeping track of where we are in the pixel data
-    uint8_t *      mPixelData = NULL;
+    const uint8_t * mPixelData = NULL;
     int            mSize = 0;
     int            mCurByte;
-    uint16_t       mCurPulse;
+    int            mCurPulse;
+
+    // -- Underrun detection. mHalfTime holds how long each half of the
+    //    RMT buffer takes to send, as last filled, and mHalfEnd the time
+    //    the hardware finished (or will finish) the half being sent, all
+    //    in ESP32 cycles. mBitTime is the time for one bit of data.
+    //    mTimed is false until mHalfEnd has been read on the core that
+    //    runs the interrupt handler.
+    uint32_t       mBitTime;
+    uint32_t       mHalfTime[2];
+    uint32_t       mHalfEnd;
+    bool           mTimed;
+    bool           mLatchFirst;
+    int            mRetries;
+
+    // -- Staging buffers for the raw pixel data. The next frame is
+    //    copied into mStaging[gBack]; when it is started, that buffer
+    //    becomes mPixelData. With FASTLED_RMT_DOUBLE_BUFFER the two
+    //    buffers take turns, otherwise only the first one is used.
+    uint8_t *      mStaging[2] = {NULL, NULL};
+    int            mStagingSize = 0;
+    int            mStagingLen[2] = {0, 0};
+
+    // -- Buffers of this controller's own, used only when the arena
+    //    could not be grown to hold them
+    uint8_t *      mOwnBuffer = NULL;
+
+    // -- When a frame needs no scaling, dithering or reordering, it is
+    //    sent straight from the leds instead of a staging buffer
+    const uint8_t * mDirect[2] = {NULL, NULL};
 
-    // -- Buffer to hold all of the pulses. For the version that uses
-    //    the RMT driver built into the ESP core.
-    rmt_item32_t * mBuffer;
-    uint16_t       mBufferSize;
 
 public:
 
@@ -221,15 +568,34 @@ public:
         mZero.level1 = 0;
         mZero.duration1 = TO_RMT_CYCLES(T2 + T3);
 
+        mBitTime = T1 + T2 + T3;
+
+        // -- Expand them into the per-byte table used by the refill code
+        ClocklessRMTPulseTable<T1, T2, T3>::build(mZero.val, mOne.val);
+        mPulseTable = ClocklessRMTPulseTable<T1, T2, T3>::mPulses;
+        mTranslator = ClocklessRMTPulseTable<T1, T2, T3>::translate;
+
+        mIndex = gNumControllers;
         gControllers[gNumControllers] = this;
         gNumControllers++;
 
         mPin = gpio_num_t(DATA_PIN);
-        printf("NUMBYTES %d\n", nBytes);
     }
 
     virtual uint16_t getMaxRefreshRate() const { return 400; }
 
+    // -- Wait for the frame in flight, if any, to be completely sent
+    virtual void waitForShow() { waitForFrame(); }
+
+    // -- Allocate the buffers for all controllers now
+    virtual void reserve() { allocArena(); }
+
+    virtual bool isShowing()
+    {
+        if (FASTLED_RMT_TX_TASK) return gTxTail != gTxHead;
+        return gShowing;
+    }
+
 protected:
 
     void initRMT()
@@ -237,15 +603,19 @@ protected:
         // -- Only need to do this once
         if (gInitialized) return;
 
-        for (int i = 0; i < FASTLED_RMT_MAX_CHANNELS; i++) {
+        for (int i = 0; i < RMT_CHANNEL_MAX; i++) {
             gOnChannel[i] = NULL;
+        }
+
+        for (int ch = 0; ch < FASTLED_RMT_NUM_CHANNELS; ch++) {
+            int i = RMT_HW_CHANNEL(ch);
 
             // -- RMT configuration for transmission
             rmt_config_t rmt_tx;
             rmt_tx.channel = rmt_channel_t(i);
             rmt_tx.rmt_mode = RMT_MODE_TX;
             rmt_tx.gpio_num = mPin;  // The particular pin will be assigned later
-            rmt_tx.mem_block_num = 1;
+            rmt_tx.mem_block_num = FASTLED_RMT_MEM_BLOCKS;
             rmt_tx.clk_div = DIVIDER;
             rmt_tx.tx_config.loop_en = false;
             rmt_tx.tx_config.carrier_level = RMT_CARRIER_LEVEL_LOW;
@@ -277,8 +647,10 @@ protected:
             //    interrupt handler must work for all different kinds of
             //    strips, so it delegates to the refill function for each
             //    specific instantiation of ClocklessController.
-            if (gRMT_intr_handle == NULL)
+            if (gRMT_intr_handle == NULL) {
                 esp_intr_alloc(ETS_RMT_INTR_SOURCE, 0, interruptHandler, 0, &gRMT_intr_handle);
+                gRMT_intr_core = xPortGetCoreID();
+            }
         }
 
         gInitialized = true;
@@ -288,12 +660,7 @@ protected:
     //    This is the main entry point for the controller.
     virtual void showPixels(PixelController<RGB_ORDER> & pixels)
     {
-        // printf("showpixels NUMBYTES %d\n", pixels.nBytes);
-        if (gNumStarted == 0) {
-            // -- First controller: make sure everything is set up
-            initRMT();
-            xSemaphoreTake(gTX_sem, portMAX_DELAY);
-        }
+        beginShow();
 
         // -- Initialize the local state, save a pointer to the pixel
         //    data. We need to make a copy because pixels is a local
@@ -302,37 +669,324 @@ protected:
 
         //if (mPixels != NULL) delete mPixels;
         //mPixels = new PixelController<RGB_ORDER>(pixels);
-        if (FASTLED_RMT_BUILTIN_DRIVER)
-            convertAllPixelData(pixels);
-        else
-            copyPixelData(pixels);
+        copyPixelData(pixels);
+
+        endShow();
+    }
+
+    // -- Show 16 bit pixels
+    //    Same as showPixels, but the data is dithered down to 8 bits as
+    //    it is copied
+    virtual void showPixels16(PixelController<RGB_ORDER> & pixels)
+    {
+        beginShow();
+        copyPixelData16(pixels);
+        endShow();
+    }
 
+    // -- That goes straight into the staging buffers, so 16 bit leds
+    //    need no buffer of their own
+    virtual void reserve16(int /*nLeds*/) {}
+
+    // -- Leave this controller out of the frame (see FastLED.showDirty)
+    //    Nothing is sent to the strip, so it keeps showing what it was
+    //    last sent. An empty buffer is left out of the schedule.
+    virtual void skipShow()
+    {
+        beginShow();
+        mDirect[gBack] = NULL;
+        mStagingLen[gBack] = 0;
+        endShow();
+    }
+
+    // -- Called by every controller before it prepares its data
+    void beginShow()
+    {
+        if (gNumStarted == 0) {
+            allocArena();
+            if (FASTLED_RMT_TX_TASK) {
+                // -- First controller: make sure the transmit task is
+                //    running, and wait until it is done with the buffer we
+                //    are about to fill (the one from two frames ago).
+                startTxTask();
+                waitForTxTask(gTxHead - 1);
+            } else {
+                // -- First controller: make sure everything is set up. Unless
+                //    we have a second buffer to fill, wait here for the previous
+                //    frame to finish.
+                initRMT();
+                if ( ! FASTLED_RMT_STAGE_AHEAD)
+                    xSemaphoreTake(gTX_sem, portMAX_DELAY);
+            }
+        }
+    }
+
+    // -- Called by every controller after it prepares its data
+    void endShow()
+    {
         // -- Keep track of the number of strips we've seen
         gNumStarted++;
 
         // -- The last call to showPixels is the one responsible for doing
         //    all of the actual worl
         if (gNumStarted == gNumControllers) {
-            gNext = 0;
+            gNumStarted = 0;
 
-            // -- First, fill all the available channels
-            int channel = 0;
-            while (channel < FASTLED_RMT_MAX_CHANNELS && gNext < gNumControllers) {
-                startNext(channel);
-                channel++;
+            if (FASTLED_RMT_TX_TASK) {
+                // -- Hand the frame to the transmit task. The barrier makes
+                //    sure the pixel data is visible to the other core before
+                //    the new head is.
+                __sync_synchronize();
+                gTxHead = gTxHead + 1;
+                xTaskNotifyGive(gTxTask);
+                gBack ^= 1;
+
+                if ( ! _show_async)
+                    waitForTxTask(gTxHead);
+                return;
             }
 
+            // -- With double buffering, this is where we wait for the
+            //    previous frame.
+            if (FASTLED_RMT_STAGE_AHEAD)
+                xSemaphoreTake(gTX_sem, portMAX_DELAY);
+
+            startFrame(gBack);
+            if (FASTLED_RMT_STAGE_AHEAD) gBack ^= 1;
+
             // -- Wait here while the rest of the data is sent. The interrupt handler
             //    will keep refilling the RMT buffers until it is all sent; then it
-            //    gives the semaphore back.
-            xSemaphoreTake(gTX_sem, portMAX_DELAY);
+            //    gives the semaphore back. For FastLED.showAsync() we return
+            //    right away, and the next frame waits instead.
+            if ( ! _show_async) {
+                xSemaphoreTake(gTX_sem, portMAX_DELAY);
+                xSemaphoreGive(gTX_sem);
+            }
+        }
+    }
+
+    // -- Start sending a frame
+    //    Makes the given staging buffer current on every controller and
+    //    fills the available channels. The caller must hold gTX_sem,
+    //    which the interrupt handler gives back when the frame is done.
+    static void startFrame(int buffer)
+    {
+        for (int i = 0; i < gNumControllers; i++) {
+            static_cast<ClocklessController*>(gControllers[i])->useStaging(buffer);
+        }
+
+        // -- Longest job first: with more controllers than channels,
+        //    starting the biggest ones first keeps a long strip from
+        //    being left to run on its own at the end of the frame.
+        //    Insertion sort, stable so equal strips keep their order.
+        for (int i = 0; i < gNumControllers; i++) {
+            int size = static_cast<ClocklessController*>(gControllers[i])->frameLength();
+            int j = i;
+            while (j > 0 && static_cast<ClocklessController*>(gControllers[gOrder[j-1]])->frameLength() < size) {
+                gOrder[j] = gOrder[j-1];
+                j--;
+            }
+            gOrder[j] = i;
+        }
+
+        // -- Controllers with nothing to send sort to the end, and are
+        //    left out of the frame entirely
+        gNumActive = gNumControllers;
+        while (gNumActive > 0 && static_cast<ClocklessController*>(gControllers[gOrder[gNumActive-1]])->frameLength() == 0) {
+            gNumActive--;
+            gStats.queueDelay[gOrder[gNumActive]] = 0;
+            gStats.sendTime[gOrder[gNumActive]] = 0;
+        }
+
+        // -- Reset the counters. We hold the semaphore, so the
+        //    previous frame is done and the interrupt handler is not
+        //    using them.
+        gNumDone = 0;
+        gStats.numControllers = gNumControllers;
+        gBusyTime = 0;
+        gFrameStart = micros();
+
+        if (gNumActive == 0) {
+            gStats.wireTime = 0;
+            gStats.idleTime = 0;
+            if (_show_done_func) (*_show_done_func)(_show_done_arg);
             xSemaphoreGive(gTX_sem);
+            return;
+        }
+        gShowing = true;
+
+        // -- First, fill all the available channels. gNext is moved
+        //    past all of them before any is started, so a channel that
+        //    finishes early can only pick up the controllers after them.
+        int first = gNumActive;
+        if (first > FASTLED_RMT_NUM_CHANNELS) first = FASTLED_RMT_NUM_CHANNELS;
+        gNext = first;
+        for (int channel = 0; channel < first; channel++) {
+            ClocklessController * pController = static_cast<ClocklessController*>(gControllers[gOrder[channel]]);
+            pController->startOnChannel(RMT_HW_CHANNEL(channel));
+        }
+    }
 
-            // -- Reset the counters
-            gNumStarted = 0;
-            gNumDone = 0;
-            gNext = 0;
+    // -- Amount of data to send this frame, for scheduling
+    int frameLength() const { return mSize; }
+
+    // -- Start the transmit task
+    //    The task sets up the RMT itself, so that the interrupt is
+    //    allocated on (and always runs on) the task's core.
+    void startTxTask()
+    {
+        if (gTxTask != NULL) return;
+
+        gTxDone_sem = xSemaphoreCreateBinary();
+
+        int core = FASTLED_RMT_TX_CORE;
+        if (core < 0) core = (xPortGetCoreID() == 0) ? 1 : 0;
+        xTaskCreatePinnedToCore(txTaskMain, "fastled_tx", FASTLED_RMT_TX_STACK, this,
+                                FASTLED_RMT_TX_PRIORITY, &gTxTask, core);
+    }
+
+    // -- Wait until the transmit task has sent the first n frames
+    static void waitForTxTask(uint32_t n)
+    {
+        if (gTxTask == NULL) return;
+        while ((int32_t)(n - gTxTail) > 0)
+            xSemaphoreTake(gTxDone_sem, portMAX_DELAY);
+    }
+
+    // -- Transmit task
+    //    Consumer side of the frame queue: sends each frame handed over
+    //    by showPixels, in order, and waits for it to finish.
+    static void txTaskMain(void * arg)
+    {
+        static_cast<ClocklessController*>(arg)->initRMT();
+
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            while (gTxTail != gTxHead) {
+                __sync_synchronize();
+
+                xSemaphoreTake(gTX_sem, portMAX_DELAY);
+                startFrame(gTxTail & 1);
+                xSemaphoreTake(gTX_sem, portMAX_DELAY);
+                xSemaphoreGive(gTX_sem);
+
+                gTxTail = gTxTail + 1;
+                xSemaphoreGive(gTxDone_sem);
+            }
+        }
+    }
+
+    // -- Wait for the frame in flight, if any, to be completely sent
+    static void waitForFrame()
+    {
+        if (FASTLED_RMT_TX_TASK) {
+            waitForTxTask(gTxHead);
+            return;
+        }
+        if (gTX_sem == NULL || !gShowing) return;
+        xSemaphoreTake(gTX_sem, portMAX_DELAY);
+        xSemaphoreGive(gTX_sem);
+    }
+
+    // -- Allocate the buffers
+    //    Every controller's buffers are carved out of a single block,
+    //    allocated the first time it is needed. It is carved again
+    //    whenever a controller is added or a strip grows, and grown if
+    //    they no longer fit. If it cannot be grown, the controllers
+    //    that do not fit get buffers of their own instead.
+    static void allocArena()
+    {
+        int total = 0;
+        bool fits = true;
+        for (int i = 0; i < gNumControllers; i++) {
+            ClocklessController * pController = static_cast<ClocklessController*>(gControllers[i]);
+            total += pController->arenaBytes();
+            if (pController->mStagingSize < pController->size() * pController->nBytes) fits = false;
         }
+        if (fits) return;
+
+        // -- Nothing may be sent from the buffers while they move
+        waitForFrame();
+
+        if (total > gArenaSize) {
+            uint8_t * arena = (uint8_t *) malloc(total);
+            if (arena == NULL) {
+                ESP_LOGE("FastLED", "RMT: no memory for %d bytes of staging buffers", total);
+                for (int i = 0; i < gNumControllers; i++) {
+                    ClocklessController * pController = static_cast<ClocklessController*>(gControllers[i]);
+                    if (pController->mStagingSize < pController->size() * pController->nBytes)
+                        pController->growStaging(pController->size());
+                }
+                return;
+            }
+            free(gArena);
+            gArena = arena;
+            gArenaSize = total;
+        }
+
+        uint8_t * mem = gArena;
+        for (int i = 0; i < gNumControllers; i++) {
+            ClocklessController * pController = static_cast<ClocklessController*>(gControllers[i]);
+            pController->useArena(mem);
+            mem += pController->arenaBytes();
+        }
+    }
+
+    // -- How much of the arena this controller needs: one or two
+    //    staging buffers. Kept a multiple of 4 so that every buffer is
+    //    word aligned.
+    int arenaBytes() { return stagingBytes(this->size()); }
+
+    int stagingBytes(int nPixels)
+    {
+        int bytes = (nPixels * nBytes + 3) & ~3;
+        return FASTLED_RMT_STAGE_AHEAD ? 2 * bytes : bytes;
+    }
+
+    void useArena(uint8_t * mem)
+    {
+        if (mOwnBuffer != NULL && mem != mOwnBuffer) {
+            free(mOwnBuffer);
+            mOwnBuffer = NULL;
+        }
+        carveStaging(mem, this->size());
+    }
+
+    void carveStaging(uint8_t * mem, int nPixels)
+    {
+        int bytes = nPixels * nBytes;
+        mStagingSize = bytes;
+        mStaging[0] = mem;
+        mStaging[1] = FASTLED_RMT_STAGE_AHEAD ? mem + ((bytes + 3) & ~3) : NULL;
+    }
+
+    // -- Give this controller buffers of its own, big enough for
+    //    nPixels. This is the fallback when the arena cannot hold them,
+    //    or when a frame is bigger than the strip it was sized for.
+    //    The frame in flight may be using the old ones.
+    void growStaging(int nPixels)
+    {
+        waitForFrame();
+        free(mOwnBuffer);
+        mOwnBuffer = (uint8_t *) malloc(stagingBytes(nPixels));
+        if (mOwnBuffer == NULL) {
+            ESP_LOGE("FastLED", "RMT: no memory for %d pixels on pin %d", nPixels, DATA_PIN);
+            mStagingSize = 0;
+            mStaging[0] = mStaging[1] = NULL;
+            return;
+        }
+        carveStaging(mOwnBuffer, nPixels);
+    }
+
+    // -- Make the given staging buffer the one to send
+    void useStaging(int buffer)
+    {
+        mPixelData = mDirect[buffer] ? mDirect[buffer] : mStaging[buffer];
+        mSize = mStagingLen[buffer];
+
+        // -- Never send past the end of a staging buffer
+        if (mDirect[buffer] == NULL && mSize > mStagingSize) mSize = mStagingSize;
     }
 
     // -- Copy pixel data
@@ -341,128 +995,58 @@ protected:
     //    device starts sending this data asynchronously.
     virtual void copyPixelData(PixelController<RGB_ORDER> & pixels)
     {
-        //IF 3 BYTES
-        // printf("NUM BYTES %d\n", pixels.nBytes);
-        if (nBytes == 3) {
-          // -- Make sure we have a buffer of the right size
-          //    (3 bytes per pixel)
-          int size_needed = pixels.size() * 3;
-          if (size_needed > mSize) {
-            if (mPixelData != NULL) free(mPixelData);
-            mSize = size_needed;
-            mPixelData = (uint8_t *) malloc( mSize);
-          }
-
-          // -- Cycle through the R,G, and B values in the right order,
-          //    storing the resulting raw pixel data in the buffer.
-          int cur = 0;
-          while (pixels.has(1)) {
-            mPixelData[cur++] = pixels.loadAndScale0();
-            mPixelData[cur++] = pixels.loadAndScale1();
-            mPixelData[cur++] = pixels.loadAndScale2();
-            pixels.advanceData();
-            pixels.stepDithering();
-          }
-          
-        }else if (nBytes == 4) {
-          /////////////////////////////////////////
-          // IF 4 BYTES
-          // -- Make sure we have a buffer of the right size
-          //    (3 bytes per pixel)
-          int size_needed = pixels.size() * 4;
-          if (size_needed > mSize) {
-              if (mPixelData != NULL) free(mPixelData);
-              mSize = size_needed;
-              mPixelData = (uint8_t *) malloc( mSize);
-          }
-
-          // -- Cycle through the R,G, and B values in the right order,
-          //    storing the resulting raw pixel data in the buffer.
-          int cur = 0;
-          while (pixels.has(1)) {
-              mPixelData[cur++] = pixels.loadAndScale0();
-              mPixelData[cur++] = pixels.loadAndScale1();
-              mPixelData[cur++] = pixels.loadAndScale2();
-              mPixelData[cur++] = pixels.loadAndScale3();
-              pixels.advanceData();
-              pixels.stepDithering();
-          }
-        }
-    }
-
-    // -- Convert all pixels to RMT pulses
-    //    This function is only used when the user chooses to use the
-    //    built-in RMT driver, which needs all of the RMT pulses
-    //    up-front.
-    virtual void convertAllPixelData(PixelController<RGB_ORDER> & pixels)
-    {
-        //IF 3 BYTES
-        if (pixels.nBytes == 3) {
-          // -- Compute the pulse values for the whole strip at once.
-          //    Requires a large buffer
-          mBufferSize = pixels.size() * 3 * 8;
-
-          if (mBuffer == NULL) {
-            mBuffer = (rmt_item32_t *) calloc( mBufferSize, sizeof(rmt_item32_t));
-          }
-
-          // -- Cycle through the R,G, and B values in the right order,
-          //    storing the pulses in the big buffer
-          mCurPulse = 0;
-          int cur = 0;
-          uint32_t byteval;
-          while (pixels.has(1)) {
-            byteval = pixels.loadAndScale0();
-            convertByte(byteval);
-            byteval = pixels.loadAndScale1();
-            convertByte(byteval);
-            byteval = pixels.loadAndScale2();
-            convertByte(byteval);
-            pixels.advanceData();
-            pixels.stepDithering();
-          }
-        } else if (pixels.nBytes == 3) {
-          /////////////////////////////////////////
-          //IF 4 BYTES
-          // -- Compute the pulse values for the whole strip at once.
-          //    Requires a large buffer
-          mBufferSize = pixels.size() * 4 * 8;
-
-          if (mBuffer == NULL) {
-              mBuffer = (rmt_item32_t *) calloc( mBufferSize, sizeof(rmt_item32_t));
-          }
-
-          // -- Cycle through the R,G, and B values in the right order,
-          //    storing the pulses in the big buffer
-          mCurPulse = 0;
-          int cur = 0;
-          uint32_t byteval;
-          while (pixels.has(1)) {
-              byteval = pixels.loadAndScale0();
-              convertByte(byteval);
-              byteval = pixels.loadAndScale1();
-              convertByte(byteval);
-              byteval = pixels.loadAndScale2();
-              convertByte(byteval);
-              byteval = pixels.loadAndScale3();
-              convertByte(byteval);
-              pixels.advanceData();
-              pixels.stepDithering();
-          }
-        }
-
-        mBuffer[mCurPulse-1].duration1 = RMT_RESET_DURATION;
-        assert(mCurPulse == mBufferSize);
-    }
-
-    void convertByte(uint32_t byteval)
-    {
-        // -- Write one byte's worth of RMT pulses to the big buffer
-        byteval <<= 24;
-        for (register uint32_t j = 0; j < 8; j++) {
-            mBuffer[mCurPulse] = (byteval & 0x80000000L) ? mOne : mZero;
-            byteval <<= 1;
-            mCurPulse++;
+        // -- If the bytes would come out unchanged, skip the copy and
+        //    send the leds themselves. Only for a synchronous show: the
+        //    program must not change them while they are being sent.
+        mDirect[gBack] = NULL;
+        if (numBytes == 4 && ! _show_async && pixels.isIdentity()) {
+            mDirect[gBack] = pixels.mData;
+            mStagingLen[gBack] = pixels.size() * 4;
+            return;
+        }
+
+        // -- Make room for a frame bigger than the strip, or else only
+        //    send as many pixels as the buffer holds
+        int nPixels = pixels.size();
+        if (nPixels * numBytes > mStagingSize) growStaging(nPixels);
+        if (nPixels * numBytes > mStagingSize) nPixels = mStagingSize / numBytes;
+        uint8_t * pData = mStaging[gBack];
+        mStagingLen[gBack] = nPixels * numBytes;
+
+        // -- Scale, dither and reorder the color values, storing the
+        //    resulting raw pixel data in the buffer. This does a whole
+        //    pixel at a time, with numBytes bytes of it sent.
+        pixels.template loadAndScalePixels<numBytes>(pData, nPixels);
+    }
+
+    // -- Copy 16 bit pixel data
+    //    Like copyPixelData, for a controller attached to CRGBW16 leds
+    void copyPixelData16(PixelController<RGB_ORDER> & pixels)
+    {
+        int nPixels = pixels.size();
+        if (nPixels * numBytes > mStagingSize) growStaging(nPixels);
+        if (nPixels * numBytes > mStagingSize) nPixels = mStagingSize / numBytes;
+        uint8_t * pData = mStaging[gBack];
+        mStagingLen[gBack] = nPixels * numBytes;
+        mDirect[gBack] = NULL;
+
+        if (numBytes == 4) {
+            for (int i = 0; i < nPixels; i++) {
+                pData[0] = pixels.loadAndScale16_0();
+                pData[1] = pixels.loadAndScale16_1();
+                pData[2] = pixels.loadAndScale16_2();
+                pData[3] = pixels.loadAndScale16_3();
+                pData += 4;
+                pixels.advanceData();
+            }
+        } else {
+            for (int i = 0; i < nPixels; i++) {
+                pData[0] = pixels.loadAndScale16_0();
+                pData[1] = pixels.loadAndScale16_1();
+                pData[2] = pixels.loadAndScale16_2();
+                pData += 3;
+                pixels.advanceData();
+            }
         }
     }
 
@@ -471,8 +1055,8 @@ protected:
     //    appropriate startOnChannel method of the given controller.
     static void startNext(int channel)
     {
-        if (gNext < gNumControllers) {
-            ClocklessController * pController = static_cast<ClocklessController*>(gControllers[gNext]);
+        if (gNext < gNumActive) {
+            ClocklessController * pController = static_cast<ClocklessController*>(gControllers[gOrder[gNext]]);
             pController->startOnChannel(channel);
             gNext++;
         }
@@ -486,6 +1070,9 @@ protected:
         // -- Assign this channel and configure the RMT
         mRMT_channel = rmt_channel_t(channel);
 
+        mStartTime = micros();
+        gStats.queueDelay[mIndex] = mStartTime - gFrameStart;
+
         // -- Store a reference to this controller, so we can get it
         //    inside the interrupt handler
         gOnChannel[channel] = this;
@@ -494,30 +1081,104 @@ protected:
         rmt_set_pin(mRMT_channel, RMT_MODE_TX, mPin);
 
         if (FASTLED_RMT_BUILTIN_DRIVER) {
-            // -- Use the built-in RMT driver to send all the data in one shot
+            // -- Use the built-in RMT driver to send all the data in one
+            //    shot; it calls our translator to convert it as it goes
             rmt_register_tx_end_callback(doneOnChannel, 0);
-            rmt_write_items(mRMT_channel, mBuffer, mBufferSize, false);
+            rmt_translator_init(mRMT_channel, mTranslator);
+            rmt_write_sample(mRMT_channel, mPixelData, mSize, false);
         } else {
             // -- Use our custom driver to send the data incrementally
+            mRetries = 0;
+            mLatchFirst = false;
+            startTransmit();
+        }
+    }
 
-            // -- Turn on the interrupts
-            rmt_set_tx_intr_en(mRMT_channel, true);
-        
-            // -- Initialize the counters that keep track of where we are in
-            //    the pixel data.
-            mCurPulse = 0;
-            mCurByte = 0;
+    // -- Send this controller's data from the start
+    void startTransmit()
+    {
+        fillRMTBuffer();
 
-            // -- Fill both halves of the buffer
-            fillHalfRMTBuffer();
-            fillHalfRMTBuffer();
+        // -- Turn on the interrupts
+        rmt_set_tx_intr_en(mRMT_channel, true);
+
+        // -- Start the RMT TX operation
+        rmt_tx_start(mRMT_channel, true);
+        startTiming();
+    }
 
-            // -- Turn on the interrupts
-            rmt_set_tx_intr_en(mRMT_channel, true);
-            
-            // -- Start the RMT TX operation
-            rmt_tx_start(mRMT_channel, true);
+    // -- Send this controller's data again from the start, from the
+    //    interrupt handler. The channel is already set up, with its
+    //    interrupts on, so this only touches the registers.
+    void IRAM_ATTR restartTransmit()
+    {
+        fillRMTBuffer();
+        RMT_TX_RESTART(mRMT_channel);
+        startTiming();
+    }
+
+    // -- Fill both halves of the buffer, from the start of the data
+    void IRAM_ATTR fillRMTBuffer()
+    {
+        mCurPulse = 0;
+        mCurByte = 0;
+        fillHalfRMTBuffer();
+        fillHalfRMTBuffer();
+    }
+
+    // -- Time the first half of the buffer from now, if we are on the
+    //    interrupt handler's core. Otherwise the handler starts the
+    //    clock the first time it runs (see underrun).
+    void IRAM_ATTR startTiming()
+    {
+        mTimed = ((int) xPortGetCoreID() == gRMT_intr_core);
+        if (mTimed) mHalfEnd = __clock_cycles() + mHalfTime[0];
+    }
+
+    // -- Check for an underrun
+    //    Called when the hardware has finished one half of the buffer
+    //    (the one at mCurPulse) and moved on to the other. That half
+    //    has to be refilled before the other one is finished, or the
+    //    hardware sends it again. Once all the data is in the buffer
+    //    the hardware stops at the end, so it cannot run over.
+    bool IRAM_ATTR underrun()
+    {
+        if (mCurByte >= mSize) return false;
+
+        // -- Started on the other core: the half just finished ended a
+        //    little before now, which makes the deadline a little late
+        if ( ! mTimed) {
+            mHalfEnd = __clock_cycles();
+            mTimed = true;
         }
+
+        int half = (mCurPulse >= MAX_PULSES) ? 1 : 0;
+        uint32_t deadline = mHalfEnd + mHalfTime[half ^ 1];
+        mHalfEnd = deadline;
+        return (int32_t)(__clock_cycles() - deadline) > 0;
+    }
+
+    // -- Stop the channel after an underrun, and send the data again
+    //    from the start if there are retries left. The new data is
+    //    preceded by a latch, so the strip ignores what was sent.
+    void IRAM_ATTR retryAfterUnderrun()
+    {
+        gCounters.underruns[mRMT_channel]++;
+        if (mRetries >= FASTLED_INTERRUPT_RETRY_COUNT) {
+            // -- Give up on this frame, and time the rest of it from now
+            mHalfEnd = __clock_cycles();
+            fillHalfRMTBuffer();
+            return;
+        }
+
+        RMT_TX_STOP(mRMT_channel);
+        mRetries++;
+        gCounters.retries[mRMT_channel]++;
+#ifdef FASTLED_DEBUG_COUNT_FRAME_RETRIES
+        _retry_cnt++;
+#endif
+        mLatchFirst = true;
+        restartTransmit();
     }
 
     // -- A controller is done 
@@ -528,7 +1189,7 @@ protected:
     //    controller is done until we look it up.
     static void doneOnChannel(rmt_channel_t channel, void * arg)
     {
-        if (channel >= FASTLED_RMT_MAX_CHANNELS) return;
+        if (channel >= RMT_CHANNEL_MAX) return;
 
         ClocklessController * controller = static_cast<ClocklessController*>(gOnChannel[channel]);
         portBASE_TYPE HPTaskAwoken = 0;
@@ -539,14 +1200,31 @@ protected:
         gOnChannel[channel] = NULL;
         gNumDone++;
 
-        if (gNumDone == gNumControllers) {
+        uint32_t now = micros();
+        uint32_t sent = now - controller->mStartTime;
+        gStats.sendTime[controller->mIndex] = sent;
+        gBusyTime += sent;
+
+        if (gNumDone == gNumActive) {
+            // -- Every channel in use was available for the whole frame;
+            //    whatever it did not spend sending was idle
+            int used = gNumActive;
+            if (used > FASTLED_RMT_NUM_CHANNELS) used = FASTLED_RMT_NUM_CHANNELS;
+            gStats.wireTime = now - gFrameStart;
+            gStats.idleTime = used * gStats.wireTime - gBusyTime;
+
             // -- If this is the last controller, signal that we are all done
+            gShowing = false;
+#ifdef FASTLED_DEBUG_COUNT_FRAME_RETRIES
+            _frame_cnt++;
+#endif
+            if (_show_done_func) (*_show_done_func)(_show_done_arg);
             xSemaphoreGiveFromISR(gTX_sem, &HPTaskAwoken);
             if(HPTaskAwoken == pdTRUE) portYIELD_FROM_ISR();
         } else {
             // -- Otherwise, if there are still controllers waiting, then
             //    start the next one on this channel
-            if (gNext < gNumControllers)
+            if (gNext < gNumActive)
                 startNext(channel);
         }
     }
@@ -559,10 +1237,10 @@ protected:
     {
         // -- The basic structure of this code is borrowed from the
         //    interrupt handler in esp-idf/components/driver/rmt.c
-        uint32_t intr_st = RMT.int_st.val;
+        uint32_t intr_st = RMT_INTR_STATUS();
         uint8_t channel;
 
-        for (channel = 0; channel < FASTLED_RMT_MAX_CHANNELS; channel++) {
+        for (channel = 0; channel < RMT_HW_CHANNEL(FASTLED_RMT_NUM_CHANNELS); channel += FASTLED_RMT_MEM_BLOCKS) {
             int tx_done_bit = channel * 3;
             int tx_next_bit = channel + 24;
 
@@ -570,16 +1248,22 @@ protected:
 
                 // -- More to send on this channel
                 if (intr_st & BIT(tx_next_bit)) {
-                    RMT.int_clr.val |= BIT(tx_next_bit);
+                    RMT_INTR_CLEAR(BIT(tx_next_bit));
                     
                     // -- Refill the half of the buffer that we just finished,
-                    //    allowing the other half to proceed.
+                    //    allowing the other half to proceed. If we are too
+                    //    late, the hardware has already sent it again.
                     ClocklessController * controller = static_cast<ClocklessController*>(gOnChannel[channel]);
-                    controller->fillHalfRMTBuffer();
+                    if (controller->underrun()) {
+                        RMT_INTR_CLEAR(BIT(tx_done_bit));
+                        controller->retryAfterUnderrun();
+                    } else {
+                        controller->fillHalfRMTBuffer();
+                    }
                 } else {
                     // -- Transmission is complete on this channel
                     if (intr_st & BIT(tx_done_bit)) {
-                        RMT.int_clr.val |= BIT(tx_done_bit);
+                        RMT_INTR_CLEAR(BIT(tx_done_bit));
                         doneOnChannel(rmt_channel_t(channel), 0);
                     }
                 }
@@ -588,39 +1272,65 @@ protected:
     }
 
     // -- Fill the RMT buffer
-    //    This function fills the next 32 slots in the RMT write
-    //    buffer with pixel data. It also handles the case where the
+    //    This function fills the next MAX_PULSES slots in the RMT write
+    //    buffer with pixel data. When a channel owns several memory
+    //    blocks they are contiguous, so the buffer simply runs on past
+    //    the end of this channel's first block. It also handles the case where the
     //    pixel data is exhausted, so we need to fill the RMT buffer
-    //    with zeros to signal that it's done.
-    void fillHalfRMTBuffer()
+    //    with zeros to signal that it's done. After an underrun, the
+    //    first half is a latch instead of data.
+    void IRAM_ATTR fillHalfRMTBuffer()
     {
-        uint32_t one_val = mOne.val;
-        uint32_t zero_val = mZero.val;
+        volatile uint32_t * dest = RMT_CHANNEL_MEM(mRMT_channel) + mCurPulse;
+        int half = (mCurPulse >= MAX_PULSES) ? 1 : 0;
+
+        if (mLatchFirst) {
+            for (int i = 0; i < MAX_PULSES; i++)
+                dest[i] = RMT_LATCH_DURATION | (RMT_LATCH_DURATION << 16);
+            mHalfTime[half] = RMT_TO_ESPCLKS(2 * MAX_PULSES * RMT_LATCH_DURATION);
+            mCurPulse += MAX_PULSES;
+            mLatchFirst = false;
+            return;
+        }
 
-        // -- Convert (up to) 32 bits of the raw pixel data into
-        //    into RMT pulses that encode the zeros and ones.
+        // -- Convert (up to) MAX_PULSES bits of the raw pixel data into
+        //    into RMT pulses that encode the zeros and ones. Each byte
+        //    is a copy of its eight precomputed items from the table.
         int pulses = 0;
-        uint32_t byteval;
-        while (pulses < 32 && mCurByte < mSize) {
-            // -- Get one byte
-            byteval = mPixelData[mCurByte++];
-            byteval <<= 24;
-            // Shift bits out, MSB first, setting RMTMEM.chan[n].data32[x] to the 
-            // rmt_item32_t value corresponding to the buffered bit value
-            for (register uint32_t j = 0; j < 8; j++) {
-                uint32_t val = (byteval & 0x80000000L) ? one_val : zero_val;
-                RMTMEM.chan[mRMT_channel].data32[mCurPulse].val = val;
-                byteval <<= 1;
-                mCurPulse++;
-            }
+        const uint32_t * src = NULL;
+        while (pulses < MAX_PULSES && mCurByte < mSize) {
+            src = mPulseTable + (mPixelData[mCurByte++] << 3);
+            dest[0] = src[0];
+            dest[1] = src[1];
+            dest[2] = src[2];
+            dest[3] = src[3];
+            dest[4] = src[4];
+            dest[5] = src[5];
+            dest[6] = src[6];
+            dest[7] = src[7];
+            dest += 8;
             pulses += 8;
         }
+        mCurPulse += pulses;
+        mHalfTime[half] = pulses * mBitTime;
+
+        // -- The last item of the frame holds the line low long enough to
+        //    latch the strip, as the translator does for the built-in
+        //    driver. The channel is not done until then, so a frame that
+        //    follows straight on (showAsync, double buffering) cannot run
+        //    into this one.
+        if (mCurByte == mSize && src) {
+            rmt_item32_t last;
+            last.val = src[7];
+            last.duration1 = RMT_RESET_DURATION;
+            dest[-1] = last.val;
+        }
 
         // -- When we reach the end of the pixel data, fill the rest of the
         //    RMT buffer with 0's, which signals to the device that we're done.
         if (mCurByte == mSize) {
-            while (pulses < 32) {
-                RMTMEM.chan[mRMT_channel].data32[mCurPulse].val = 0;
+            while (pulses < MAX_PULSES) {
+                *dest++ = 0;
                 mCurPulse++;
                 pulses++;
             }
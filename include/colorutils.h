@@ -13,6 +13,12 @@ FASTLED_NAMESPACE_BEGIN
 ///A variety of functions for working with color, palletes, and leds
 ///@{
 
+// The functions here that write to arrays of leds report the leds they
+// changed to the power tracker (see power_mgt.h).  Arrays of CHSV are
+// never shown, so changes to them are not reported.
+void power_track_changed( const CRGBW* leds, int count);
+inline void power_track_changed( const CHSV*, int) {}
+
 /// fill_solid -   fill a range of LEDs with a solid color
 ///                Example: fill_solid( leds, NUM_LEDS, CRGBW(50,0,200));
 void fill_solid( struct CRGBW * leds, int numToFill,
@@ -174,6 +180,7 @@ void fill_gradient( T* targetArray,
         sat88 += satdelta87;
         val88 += valdelta87;
     }
+    power_track_changed( targetArray + startpos, endpos - startpos + 1);
 }
 
 
@@ -280,7 +287,9 @@ CHSV  blend( const CHSV& p1, const CHSV& p2, fract8 amountOfP2,
 // blend - computes a new color blended array of colors, each
 //         a given fraction of the way between corresponding
 //         elements of two source arrays of colors.
-//         Useful for blending palettes.
+//         Useful for blending palettes, or for crossfading
+//         between two whole frames of leds.  dest may be
+//         the same array as src1 or src2.
 CRGBW* blend( const CRGBW* src1, const CRGBW* src2, CRGBW* dest,
              uint16_t count, fract8 amountOfsrc2 );
 
@@ -317,12 +326,23 @@ void  nblend( CHSV* existing, CHSV* overlay, uint16_t count, fract8 amountOfOver
 //         eventually all the way to black; this is by design so that
 //         it can be used to (slowly) clear the LEDs to black.
 void blur1d( CRGBW* leds, uint16_t numLeds, fract8 blur_amount);
-void blur2d( CRGBW* leds, uint8_t width, uint8_t height, fract8 blur_amount);
+//
+//         The 2D functions find each led either through the
+//         application's XY function, or through a CXYMap (see xymap.h),
+//         which can be used for matrices of any size.  Matrices wider
+//         or taller than 256 can't be reached through XY, so without
+//         a map their leds are taken to be in plain rows.
+//
+//         blur2d goes through the leds once, a row at a time.
+void blur2d( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount);
+void blur2d( CRGBW* leds, const CXYMap& map, fract8 blur_amount);
 
 // blurRows: perform a blur1d on every row of a rectangular matrix
-void blurRows( CRGBW* leds, uint8_t width, uint8_t height, fract8 blur_amount);
+void blurRows( CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount);
+void blurRows( CRGBW* leds, const CXYMap& map, fract8 blur_amount);
 // blurColumns: perform a blur1d on each column of a rectangular matrix
-void blurColumns(CRGBW* leds, uint8_t width, uint8_t height, fract8 blur_amount);
+void blurColumns(CRGBW* leds, uint16_t width, uint16_t height, fract8 blur_amount);
+void blurColumns(CRGBW* leds, const CXYMap& map, fract8 blur_amount);
 
 
 // CRGBW HeatColor( uint8_t temperature)
@@ -453,11 +473,11 @@ public:
 
     CHSVPalette16( const CHSVPalette16& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
     }
     CHSVPalette16& operator=( const CHSVPalette16& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
         return *this;
     }
 
@@ -556,11 +576,11 @@ public:
 
     CHSVPalette256( const CHSVPalette256& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
     }
     CHSVPalette256& operator=( const CHSVPalette256& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
         return *this;
     }
 
@@ -661,20 +681,20 @@ public:
 
     CRGBWPalette16( const CRGBWPalette16& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
     }
     CRGBWPalette16( const CRGBW rhs[16])
     {
-        memmove8( &(entries[0]), &(rhs[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs[0]), sizeof( entries));
     }
     CRGBWPalette16& operator=( const CRGBWPalette16& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
         return *this;
     }
     CRGBWPalette16& operator=( const CRGBW rhs[16])
     {
-        memmove8( &(entries[0]), &(rhs[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs[0]), sizeof( entries));
         return *this;
     }
 
@@ -929,11 +949,11 @@ public:
     
     CHSVPalette32( const CHSVPalette32& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
     }
     CHSVPalette32& operator=( const CHSVPalette32& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
         return *this;
     }
     
@@ -1035,20 +1055,20 @@ public:
     
     CRGBWPalette32( const CRGBWPalette32& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
     }
     CRGBWPalette32( const CRGBW rhs[32])
     {
-        memmove8( &(entries[0]), &(rhs[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs[0]), sizeof( entries));
     }
     CRGBWPalette32& operator=( const CRGBWPalette32& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
         return *this;
     }
     CRGBWPalette32& operator=( const CRGBW rhs[32])
     {
-        memmove8( &(entries[0]), &(rhs[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs[0]), sizeof( entries));
         return *this;
     }
     
@@ -1323,20 +1343,20 @@ public:
 
     CRGBWPalette256( const CRGBWPalette256& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
     }
     CRGBWPalette256( const CRGBW rhs[256])
     {
-        memmove8( &(entries[0]), &(rhs[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs[0]), sizeof( entries));
     }
     CRGBWPalette256& operator=( const CRGBWPalette256& rhs)
     {
-        memmove8( &(entries[0]), &(rhs.entries[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs.entries[0]), sizeof( entries));
         return *this;
     }
     CRGBWPalette256& operator=( const CRGBW rhs[256])
     {
-        memmove8( &(entries[0]), &(rhs[0]), sizeof( entries));
+        memmove8( (void*)&(entries[0]), &(rhs[0]), sizeof( entries));
         return *this;
     }
 
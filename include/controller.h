@@ -13,11 +13,16 @@
 FASTLED_NAMESPACE_BEGIN
 
 #define RO(X) RGB_BYTE(RGB_ORDER, X)
-#define RGB_BYTE(RO,X) (((RO)>>(3*(2-(X)))) & 0x3)
+// Which byte of a CRGBW goes out in position X. Orders with the W position
+// flag (see EOrder) give all four positions; for the others the white byte
+// always comes last, after the three color bytes in RO order. RGB_ORDER is
+// a template parameter, so this is always a compile time constant.
+#define RGB_BYTE(RO,X) (((RO) & EORDER_W_FLAG) ? (((RO)>>(3*(3-(X)))) & 0x3) : \
+                        (((X) == 3) ? 3 : (((RO)>>(3*(2-(X)))) & 0x3)))
 
-#define RGB_BYTE0(RO) ((RO>>6) & 0x3)
-#define RGB_BYTE1(RO) ((RO>>3) & 0x3)
-#define RGB_BYTE2(RO) ((RO) & 0x3)
+#define RGB_BYTE0(RO) RGB_BYTE(RO, 0)
+#define RGB_BYTE1(RO) RGB_BYTE(RO, 1)
+#define RGB_BYTE2(RO) RGB_BYTE(RO, 2)
 
 // operator byte *(struct CRGBW[] arr) { return (byte*)arr; }
 
@@ -25,12 +30,22 @@ FASTLED_NAMESPACE_BEGIN
 #define BINARY_DITHER 0x01
 typedef uint8_t EDitherMode;
 
+// A full cycle of temporal dithering should repeat at least this often,
+// or it shows up as flicker
+#define MIN_ACCEPTABLE_DITHER_RATE_HZ  50
+
+/// Callback run when a frame has been completely sent by a driver that
+/// sends in the background. Drivers call it from interrupt context.
+typedef void (*show_done_func)(void * arg);
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // LED Controller interface definition
 //
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+struct CPowerProfile;
+
 /// Base definition for an LED controller.  Pretty much the methods that every LED controller object will make available.
 /// Note that the showARGB method is not impelemented for all controllers yet.   Note also the methods for eventual checking
 /// of background writing of data (I'm looking at you, teensy 3.0 DMA controller!).  If you want to pass LED controllers around
@@ -40,11 +55,17 @@ class CLEDController {
 protected:
     friend class CFastLED;
     CRGBW *m_Data;
+    CRGBW16 *m_Data16;
     CLEDController *m_pNext;
     CRGBW m_ColorCorrection;
     CRGBW m_ColorTemperature;
     EDitherMode m_DitherMode;
     int m_nLeds;
+    bool m_bDirty;
+    uint8_t m_nDitherFrame;
+    uint32_t m_nLastShow;
+    const CPowerProfile *m_pPowerProfile;
+    uint8_t m_nPowerZone;
     static CLEDController *m_pHead;
     static CLEDController *m_pTail;
 
@@ -60,10 +81,21 @@ protected:
 	///@param scale the rgb scaling to apply to each led before writing it out
     virtual void show(const struct CRGBW *data, int nLeds, CRGBW scale) = 0;
 
+	/// write the passed in 16 bit rgbw data out to the leds managed by this controller.  Controllers
+	/// that cannot send it leave the leds alone.
+	///@param data the rgbw data to write out to the strip
+	///@param nLeds the number of leds being written out
+	///@param scale the rgb scaling to apply to each led before writing it out
+    virtual void show16(const struct CRGBW16 * /*data*/, int /*nLeds*/, CRGBW /*scale*/) {}
+
+	/// allocate whatever show16 needs for nLeds leds, so that it does not use the heap.  Called
+	/// when 16 bit leds are attached to the controller.
+    virtual void reserve16(int /*nLeds*/) {}
+
 public:
 
 	/// create an led controller object, add it to the chain of controllers
-    CLEDController() : m_Data(NULL), m_ColorCorrection(UncorrectedColor), m_ColorTemperature(UncorrectedTemperature), m_DitherMode(BINARY_DITHER), m_nLeds(0) {
+    CLEDController() : m_Data(NULL), m_Data16(NULL), m_ColorCorrection(UncorrectedColor), m_ColorTemperature(UncorrectedTemperature), m_DitherMode(BINARY_DITHER), m_nLeds(0), m_bDirty(true), m_nDitherFrame(0), m_nLastShow(0), m_pPowerProfile(NULL), m_nPowerZone(0) {
         m_pNext = NULL;
         if(m_pHead==NULL) { m_pHead = this; }
         if(m_pTail != NULL) { m_pTail->m_pNext = this; }
@@ -88,7 +120,11 @@ public:
 
     /// show function using the "attached to this controller" led data
     void showLeds(uint8_t brightness=255) {
-        show(m_Data, m_nLeds, getAdjustment(brightness));
+        if(m_Data16) {
+            show16(m_Data16, m_nLeds, getAdjustment(brightness));
+        } else {
+            show(m_Data, m_nLeds, getAdjustment(brightness));
+        }
     }
 
 	/// show the given color on the led strip
@@ -104,7 +140,17 @@ public:
 	/// set the default array of leds to be used by this controller
     CLEDController & setLeds(CRGBW *data, int nLeds) {
         m_Data = data;
+        m_Data16 = NULL;
+        m_nLeds = nLeds;
+        return *this;
+    }
+
+	/// use an array of 16 bit leds for this controller instead.  leds() is NULL from then on.
+    CLEDController & setLeds(CRGBW16 *data, int nLeds) {
+        m_Data = NULL;
+        m_Data16 = data;
         m_nLeds = nLeds;
+        reserve16(nLeds);
         return *this;
     }
 
@@ -121,6 +167,9 @@ public:
     /// Pointer to the CRGBW array for this controller
     CRGBW* leds() { return m_Data; }
 
+    /// Pointer to the CRGBW16 array for this controller, if it has one
+    CRGBW16* leds16() { return m_Data16; }
+
     /// Reference to the n'th item in the controller
     CRGBW &operator[](int x) { return m_Data[x]; }
 
@@ -143,6 +192,17 @@ public:
     /// get the color temperature, aka whipe point, for this controller
     CRGBW getTemperature() { return m_ColorTemperature; }
 
+    /// set how much power the leds of this controller draw (see power_mgt.h).  The profile is not
+    /// copied, so it has to outlive the controller.
+    CLEDController & setPowerProfile(const CPowerProfile & profile) { m_pPowerProfile = &profile; return *this; }
+    /// get the power profile of this controller, or NULL for the default one
+    const CPowerProfile *getPowerProfile() { return m_pPowerProfile; }
+
+    /// set the power zone, that is the power supply, this controller's leds are on (see power_mgt.h)
+    CLEDController & setPowerZone(uint8_t zone) { m_nPowerZone = zone; return *this; }
+    /// get the power zone of this controller
+    uint8_t getPowerZone() { return m_nPowerZone; }
+
 	/// Get the combined brightness/color adjustment for this controller
     CRGBW getAdjustment(uint8_t scale) {
         return computeAdjustment(scale, m_ColorCorrection, m_ColorTemperature);
@@ -170,6 +230,43 @@ public:
       #endif
     }
     virtual uint16_t getMaxRefreshRate() const { return 0; }
+
+    /// allocate any output buffers now, rather than on the first show
+    virtual void reserve() {}
+
+    /// wait until any data this controller is sending in the background has been sent
+    virtual void waitForShow() {}
+
+    /// is this controller still sending data in the background?
+    virtual bool isShowing() { return false; }
+
+    /// note that the leds of this controller have changed, so that FastLED.showDirty sends them
+    CLEDController & markDirty() { m_bDirty = true; return *this; }
+
+    /// have the leds of this controller changed since they were last shown?
+    bool isDirty() { return m_bDirty; }
+
+    /// called instead of showLeds when this controller is left out of a frame (see FastLED.showDirty)
+    virtual void skipShow() {}
+
+    /// Step this controller's temporal dithering on to a new frame.  The number of dithering bits
+    /// comes from the time since this controller was last shown: as many as still let a full
+    /// dithering cycle run at MIN_ACCEPTABLE_DITHER_RATE_HZ.  Each doubling of the frame rate adds
+    /// a bit; no bits means the frame rate is too low to dither at all.
+    ///@param frame set to this controller's dithering frame counter
+    ///@returns the number of dithering bits to use for this frame, 0 to 8
+    uint8_t stepDither(uint8_t & frame) {
+        uint32_t now = micros();
+        uint32_t elapsed = now - m_nLastShow;
+        m_nLastShow = now;
+
+        // -- Another bit doubles the cycle to 2^(bits+1) frames, which must still fit in the period
+        uint8_t bits = 0;
+        while(bits < 8 && elapsed < ((1000000UL / MIN_ACCEPTABLE_DITHER_RATE_HZ) >> (bits + 1))) { bits++; }
+
+        frame = ++m_nDitherFrame;
+        return bits;
+    }
 };
 
 // Pixel controller class.  This is the class that we use to centralize pixel access in a block of data, including
@@ -181,10 +278,10 @@ struct PixelController {
         int mLen,mLenRemaining;
         uint8_t d[4];
         uint8_t e[4];
+        uint8_t mThreshold;
         CRGBW mScale;
         int8_t mAdvance;
         int mOffsets[LANES];
-        int nBytes;
 
         PixelController(const PixelController & other) {
             d[0] = other.d[0];
@@ -195,6 +292,7 @@ struct PixelController {
             e[1] = other.e[1];
             e[2] = other.e[2];
             e[3] = other.e[3];
+            mThreshold = other.mThreshold;
             mData = other.mData;
             mScale = other.mScale;
             mAdvance = other.mAdvance;
@@ -230,7 +328,15 @@ struct PixelController {
             initOffsets(len);
         }
 
+        // 16 bit data: only the loadAndScale16 functions may be used on it
+        PixelController(const CRGBW16 *d, int len, CRGBW & s, EDitherMode dither = BINARY_DITHER) : mData((const uint8_t*)d), mLen(len), mLenRemaining(len), mScale(s) {
+            enable_dithering(dither);
+            mAdvance = sizeof(CRGBW16);
+            initOffsets(len);
+        }
+
         void init_binary_dithering() {
+            mThreshold = 0x80;
 #if !defined(NO_DITHERING) || (NO_DITHERING != 1)
 
             // Set 'virtual bits' of dithering to the highest level
@@ -239,14 +345,11 @@ struct PixelController {
             // These pre-set values are a little ambitious, since
             // a 400Hz update rate for WS2811-family LEDs is only
             // possible with 85 pixels or fewer.
-            // Once we have a 'number of milliseconds since last update'
-            // value available here, we can quickly calculate the correct
-            // number of 'virtual bits' on the fly with a couple of 'if'
-            // statements -- no division required.  At this point,
-            // the division is done at compile time, so there's no runtime
-            // cost, but the values are still hard-coded.
+            // Controllers pick the number of 'virtual bits' for each
+            // frame from the measured time since their last update
+            // instead (see CLEDController::stepDither); these fixed
+            // values are for code that builds a PixelController itself.
 #define MAX_LIKELY_UPDATE_RATE_HZ     400
-#define MIN_ACCEPTABLE_DITHER_RATE_HZ  50
 #define UPDATES_PER_FULL_DITHER_CYCLE (MAX_LIKELY_UPDATE_RATE_HZ / MIN_ACCEPTABLE_DITHER_RATE_HZ)
 #define RECOMMENDED_VIRTUAL_BITS ((UPDATES_PER_FULL_DITHER_CYCLE>1) + \
                                   (UPDATES_PER_FULL_DITHER_CYCLE>2) + \
@@ -262,9 +365,17 @@ struct PixelController {
             static uint8_t R = 0;
             R++;
 
+            init_binary_dithering(R, VIRTUAL_BITS);
+#endif
+        }
+
+        // Set up dithering for frame number R of a cycle of 2^ditherBits frames
+        // (a controller's own frame counter, see CLEDController::stepDither)
+        void init_binary_dithering(uint8_t R, uint8_t ditherBits) {
+            mThreshold = 0x80;
+#if !defined(NO_DITHERING) || (NO_DITHERING != 1)
             // R is wrapped around at 2^ditherBits,
             // so if ditherBits is 2, R will cycle through (0,1,2,3)
-            uint8_t ditherBits = VIRTUAL_BITS;
             R &= (0x01 << ditherBits) - 1;
 
             // Q is the "unscaled dither signal" itself.
@@ -306,6 +417,10 @@ struct PixelController {
 #endif
                     if(e[i]) e[i]--;
             }
+
+            // For 16 bit data, Q itself is the threshold that the low
+            // byte of each channel has to reach to round up this frame
+            mThreshold = Q;
 #endif
         }
 
@@ -318,12 +433,29 @@ struct PixelController {
         void enable_dithering(EDitherMode dither) {
             switch(dither) {
                 case BINARY_DITHER: init_binary_dithering(); break;
-                default: d[0]=d[1]=d[2]=d[3]=e[0]=e[1]=e[2]=e[3]=0; break;
+                default: d[0]=d[1]=d[2]=d[3]=e[0]=e[1]=e[2]=e[3]=0; mThreshold=0x80; break;
             }
         }
 
         __attribute__((always_inline)) inline int size() { return mLen; }
 
+        // Would every byte be sent exactly as it is stored? That is, the
+        // data is a plain CRGBW array already in output order, and there
+        // is no scaling or dithering to apply. (scale8 by 255 is only
+        // exact with FASTLED_SCALE8_FIXED.)
+        bool isIdentity() const {
+#if (FASTLED_SCALE8_FIXED == 1)
+            if(RO(0) != 0 || RO(1) != 1 || RO(2) != 2 || RO(3) != 3) { return false; }
+            if(LANES != 1 || mAdvance != 4) { return false; }
+            for(int i = 0; i < 4; i++) {
+                if(mScale.raw[i] != 255 || d[i] || e[i]) { return false; }
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
         // get the amount to advance the pointer by
         __attribute__((always_inline)) inline int advanceBy() { return mAdvance; }
 
@@ -364,6 +496,14 @@ struct PixelController {
         template<int SLOT>  __attribute__((always_inline)) inline static uint8_t advanceAndLoadAndScale(PixelController & pc, int lane) { pc.advanceData(); return pc.loadAndScale<SLOT>(pc, lane); }
         template<int SLOT>  __attribute__((always_inline)) inline static uint8_t advanceAndLoadAndScale(PixelController & pc, int lane, uint8_t scale) { pc.advanceData(); return pc.loadAndScale<SLOT>(pc, lane, scale); }
 
+        // 16 bit data: load, scale, and dither down to 8 bits in one go. The scaled value keeps all
+        // 16 bits; its low byte decides whether it rounds up, against a threshold that cycles
+        // through the dithering steps from frame to frame.
+        template<int SLOT>  __attribute__((always_inline)) inline static uint8_t loadAndScale16(PixelController & pc) {
+            uint32_t v = scale16by8(((const uint16_t *)pc.mData)[RO(SLOT)], pc.mScale.raw[RO(SLOT)]) + pc.mThreshold;
+            return (v > 0xFFFF) ? 0xFF : (v >> 8);
+        }
+
         template<int SLOT>  __attribute__((always_inline)) inline static uint8_t getd(PixelController & pc) { return pc.d[RO(SLOT)]; }
         template<int SLOT>  __attribute__((always_inline)) inline static uint8_t getscale(PixelController & pc) { return pc.mScale.raw[RO(SLOT)]; }
 
@@ -389,22 +529,133 @@ struct PixelController {
         __attribute__((always_inline)) inline uint8_t advanceAndLoadAndScale0() { return advanceAndLoadAndScale<0>(*this); }
         __attribute__((always_inline)) inline uint8_t stepAdvanceAndLoadAndScale0() { stepDithering(); return advanceAndLoadAndScale<0>(*this); }
 
+        __attribute__((always_inline)) inline uint8_t loadAndScale16_0() { return loadAndScale16<0>(*this); }
+        __attribute__((always_inline)) inline uint8_t loadAndScale16_1() { return loadAndScale16<1>(*this); }
+        __attribute__((always_inline)) inline uint8_t loadAndScale16_2() { return loadAndScale16<2>(*this); }
+        __attribute__((always_inline)) inline uint8_t loadAndScale16_3() { return loadAndScale16<3>(*this); }
+
         __attribute__((always_inline)) inline uint8_t getScale0() { return getscale<0>(*this); }
         __attribute__((always_inline)) inline uint8_t getScale1() { return getscale<1>(*this); }
         __attribute__((always_inline)) inline uint8_t getScale2() { return getscale<2>(*this); }
         __attribute__((always_inline)) inline uint8_t getScale3() { return getscale<3>(*this); }
+
+        // Packed byte arithmetic on the four channels of a pixel held in a 32 bit word
+        // (raw[0] in the low byte, as on the little-endian ESP32)
+        static inline uint32_t packed_qadd8(uint32_t x, uint32_t y) {
+            uint32_t sum = ((x & 0x7F7F7F7F) + (y & 0x7F7F7F7F)) ^ ((x ^ y) & 0x80808080);
+            uint32_t carry = ((x & y) | ((x | y) & ~sum)) & 0x80808080;
+            return sum | ((carry >> 7) * 0xFF);
+        }
+
+        static inline uint32_t packed_sub8(uint32_t x, uint32_t y) {
+            return ((x | 0x80808080) - (y & 0x7F7F7F7F)) ^ ((x ^ ~y) & 0x80808080);
+        }
+
+        // 0xFF in every byte of x that is not zero
+        static inline uint32_t packed_nonzero(uint32_t x) {
+            return (((((x & 0x7F7F7F7F) + 0x7F7F7F7F) | x) & 0x80808080) >> 7) * 0xFF;
+        }
+
+        static inline uint32_t packed_scale8(uint32_t x, uint32_t scale) {
+#if (FASTLED_SCALE8_FIXED == 1)
+            uint32_t m = (scale & 0xFF) + 1;
+#else
+            uint32_t m = (scale & 0xFF);
+#endif
+            // -- The same scale for every channel: two channels per multiply
+            if(scale == (scale & 0xFF) * 0x01010101) {
+                return (((x & 0x00FF00FF) * m) >> 8 & 0x00FF00FF) | (((x >> 8) & 0x00FF00FF) * m & 0xFF00FF00);
+            }
+            uint32_t r = ((x & 0xFF) * m) >> 8;
+#if (FASTLED_SCALE8_FIXED == 1)
+            r |= (((x >> 8) & 0xFF) * (((scale >> 8) & 0xFF) + 1)) & 0xFF00;
+            r |= ((((x >> 16) & 0xFF) * (((scale >> 16) & 0xFF) + 1)) << 8) & 0xFF0000;
+            r |= ((((x >> 24) & 0xFF) * ((scale >> 24) + 1)) << 16) & 0xFF000000;
+#else
+            r |= (((x >> 8) & 0xFF) * ((scale >> 8) & 0xFF)) & 0xFF00;
+            r |= ((((x >> 16) & 0xFF) * ((scale >> 16) & 0xFF)) << 8) & 0xFF0000;
+            r |= ((((x >> 24) & 0xFF) * (scale >> 24)) << 16) & 0xFF000000;
+#endif
+            return r;
+        }
+
+        // Byte SLOT of the output, from a packed pixel
+        template<int SLOT> __attribute__((always_inline)) inline static uint8_t packedByte(uint32_t x) { return x >> (8 * RO(SLOT)); }
+
+        // Batched loadAndScale0..3, stepDithering and advanceData for nPixels pixels, writing
+        // BYTES (3 or 4) bytes of each to pOut.  Each pixel is loaded as a 32 bit word, dithered
+        // and scaled all at once, and written out in output order; since the dithering just
+        // alternates between two values, pixels are done in pairs.  The bytes, and the state
+        // this leaves behind, are exactly the same as the one byte at a time functions give.
+        template<int BYTES> void loadAndScalePixels(uint8_t *pOut, int nPixels) {
+            uint32_t scale = mScale.raw[0] | (mScale.raw[1] << 8) | (mScale.raw[2] << 16) | ((uint32_t)mScale.raw[3] << 24);
+            uint32_t dither0 = d[0] | (d[1] << 8) | (d[2] << 16) | ((uint32_t)d[3] << 24);
+            uint32_t dither1 = packed_sub8(e[0] | (e[1] << 8) | (e[2] << 16) | ((uint32_t)e[3] << 24), dither0);
+            bool aligned = ((((uintptr_t)mData) | mAdvance) & 3) == 0;
+
+            for(int i = 0; i < nPixels; i++) {
+                uint32_t x;
+                if(aligned) {
+                    x = *(const uint32_t *)mData;
+                } else {
+                    x = mData[0] | (mData[1] << 8) | (mData[2] << 16) | ((uint32_t)mData[3] << 24);
+                }
+                mData += mAdvance;
+
+                x = packed_scale8(packed_qadd8(x, (i & 1) ? dither1 : dither0) & packed_nonzero(x), scale);
+
+                pOut[0] = packedByte<0>(x);
+                pOut[1] = packedByte<1>(x);
+                pOut[2] = packedByte<2>(x);
+                if(BYTES == 4) { pOut[3] = packedByte<3>(x); }
+                pOut += BYTES;
+            }
+
+            mLenRemaining -= nPixels;
+            if(nPixels & 1) {
+                for(int i = 0; i < 4; i++) { d[i] = dither1 >> (8 * i); }
+            }
+        }
 };
 
 template<EOrder RGB_ORDER, int LANES=1, uint32_t MASK=0xFFFFFFFF> class CPixelLEDController : public CLEDController {
+  CRGBW *m_pData8;
+  int m_nData8;
+
 protected:
   virtual void showPixels(PixelController<RGB_ORDER,LANES,MASK> & pixels) = 0;
 
+  /// write out 16 bit pixel data, using the loadAndScale16 functions.  Controllers that don't
+  /// override this get the nearest 8 bit values instead, through showPixels, with the usual
+  /// 8 bit dithering.  (That needs a buffer, allocated by reserve16 when the leds are attached;
+  /// leds beyond it are not sent.)
+  virtual void showPixels16(PixelController<RGB_ORDER,LANES,MASK> & pixels) {
+    int nLeds = pixels.size();
+    if(nLeds > m_nData8) { nLeds = m_nData8; }
+
+    const CRGBW16 *data = (const CRGBW16*)pixels.mData;
+    for(int i = 0; i < nLeds; i++) { m_pData8[i] = data[i]; }
+
+    PixelController<RGB_ORDER, LANES, MASK> pixels8(m_pData8, nLeds, pixels.mScale, DISABLE_DITHER);
+    for(int i = 0; i < 4; i++) { pixels8.d[i] = pixels.d[i]; pixels8.e[i] = pixels.e[i]; }
+    showPixels(pixels8);
+  }
+
+  /// allocate the buffer showPixels16 converts the leds into
+  virtual void reserve16(int nLeds) {
+    if(nLeds <= m_nData8) { return; }
+    free(m_pData8);
+    m_pData8 = (CRGBW*)malloc(nLeds * sizeof(CRGBW));
+    m_nData8 = m_pData8 ? nLeds : 0;
+  }
+
   /// set all the leds on the controller to a given color
   ///@param data the crgb color to set the leds to
   ///@param nLeds the numner of leds to set to this color
   ///@param scale the rgb scaling value for outputting color
   virtual void showColor(const struct CRGBW & data, int nLeds, CRGBW scale) {
-    PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, scale, getDither());
+    PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, scale, DISABLE_DITHER);
+    initDithering(pixels);
     showPixels(pixels);
   }
 
@@ -413,12 +664,32 @@ protected:
 ///@param nLeds the number of leds being written out
 ///@param scale the rgb scaling to apply to each led before writing it out
   virtual void show(const struct CRGBW *data, int nLeds, CRGBW scale) {
-    PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, scale, getDither());
+    PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, scale, DISABLE_DITHER);
+    initDithering(pixels);
     showPixels(pixels);
   }
 
+/// write the passed in 16 bit rgbw data out to the strip, dithered down to 8 bits
+///@param data the rgbw data to write out to the strip
+///@param nLeds the number of leds being written out
+///@param scale the rgb scaling to apply to each led before writing it out
+  virtual void show16(const struct CRGBW16 *data, int nLeds, CRGBW scale) {
+    PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, scale, DISABLE_DITHER);
+    initDithering(pixels);
+    showPixels16(pixels);
+  }
+
+  /// set up this frame's dithering, with as many bits as the measured frame rate allows
+  void initDithering(PixelController<RGB_ORDER, LANES, MASK> & pixels) {
+    if(getDither() == BINARY_DITHER) {
+      uint8_t frame;
+      uint8_t bits = stepDither(frame);
+      if(bits) { pixels.init_binary_dithering(frame, bits); }
+    }
+  }
+
 public:
-  CPixelLEDController() : CLEDController() {}
+  CPixelLEDController() : CLEDController(), m_pData8(NULL), m_nData8(0) {}
 };
 
 
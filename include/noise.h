@@ -64,8 +64,8 @@ extern int8_t inoise8_raw(uint16_t x);
 ///@param scalex the scale (distance) between x points when filling in noise
 ///@param scaley the scale (distance) between y points when filling in noise
 ///@param time the time position for the noise field
-void fill_raw_noise8(uint8_t *pData, uint8_t num_points, uint8_t octaves, uint16_t x, int scalex, uint16_t time);
-void fill_raw_noise16into8(uint8_t *pData, uint8_t num_points, uint8_t octaves, uint32_t x, int scalex, uint32_t time);
+void fill_raw_noise8(uint8_t *pData, uint16_t num_points, uint8_t octaves, uint16_t x, int scalex, uint16_t time);
+void fill_raw_noise16into8(uint8_t *pData, uint16_t num_points, uint8_t octaves, uint32_t x, int scalex, uint32_t time);
 void fill_raw_2dnoise8(uint8_t *pData, int width, int height, uint8_t octaves, uint16_t x, int scalex, uint16_t y, int scaley, uint16_t time);
 void fill_raw_2dnoise16into8(uint8_t *pData, int width, int height, uint8_t octaves, uint32_t x, int scalex, uint32_t y, int scaley, uint32_t time);
 
@@ -91,6 +91,14 @@ void fill_2dnoise16(CRGBW *leds, int width, int height, bool serpentine,
             uint8_t octaves, uint32_t x, int xscale, uint32_t y, int yscale, uint32_t time,
             uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time, bool blend, uint16_t hue_shift=0);
 
+/// 2d fill functions that find each led through a CXYMap (see xymap.h), for matrices of any layout and size
+void fill_2dnoise8(CRGBW *leds, const CXYMap &map,
+            uint8_t octaves, uint16_t x, int xscale, uint16_t y, int yscale, uint16_t time,
+            uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time,bool blend);
+void fill_2dnoise16(CRGBW *leds, const CXYMap &map,
+            uint8_t octaves, uint32_t x, int xscale, uint32_t y, int yscale, uint32_t time,
+            uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time, bool blend, uint16_t hue_shift=0);
+
 FASTLED_NAMESPACE_END
 ///@}
 
@@ -165,8 +165,9 @@ struct CRGBW {
     w = rhs.w;
   }
 
-  /// allow construction from HSV color
+  /// allow construction from HSV color, with the white channel off
   inline CRGBW(const CHSV& rhs) __attribute__((always_inline))
+    : w(0)
   {
     hsv2rgb_rainbow( rhs, *this);
   }
@@ -869,17 +870,106 @@ inline CRGBW operator%( const CRGBW& p1, uint8_t d)
 }
 
 
+/// Representation of an RGBW pixel with 16 bits per channel.  Controllers
+/// attached to an array of these (see CLEDController::setLeds) dither the
+/// low byte of each channel over time, so that slow fades at low brightness
+/// do not step visibly.
+struct CRGBW16 {
+  union {
+    struct {
+      union {
+        uint16_t r;
+        uint16_t red;
+      };
+      union {
+        uint16_t g;
+        uint16_t green;
+      };
+      union {
+        uint16_t b;
+        uint16_t blue;
+      };
+      union {
+        uint16_t w;
+        uint16_t white;
+      };
+    };
+    uint16_t raw[4];
+  };
+
+  /// Array access operator to index into the crgbw16 object
+  inline uint16_t& operator[] (uint8_t x) __attribute__((always_inline))
+  {
+    return raw[x];
+  }
+
+  /// Array access operator to index into the crgbw16 object
+  inline const uint16_t& operator[] (uint8_t x) const __attribute__((always_inline))
+  {
+    return raw[x];
+  }
+
+  // default values are UNINITIALIZED
+  inline CRGBW16() __attribute__((always_inline))
+  {
+  }
+
+  /// allow construction from R, G, B, W
+  inline CRGBW16( uint16_t ir, uint16_t ig, uint16_t ib, uint16_t iw)  __attribute__((always_inline))
+    : r(ir), g(ig), b(ib), w(iw)
+  {
+  }
+
+  /// allow construction from an 8 bit pixel; 0xFF becomes 0xFFFF
+  inline CRGBW16( const CRGBW& rhs) __attribute__((always_inline))
+    : r(rhs.r * 0x101), g(rhs.g * 0x101), b(rhs.b * 0x101), w(rhs.w * 0x101)
+  {
+  }
+
+  /// allow assignment from R, G, B, and W
+  inline CRGBW16& setRGBW (uint16_t nr, uint16_t ng, uint16_t nb, uint16_t nw) __attribute__((always_inline))
+  {
+    r = nr;
+    g = ng;
+    b = nb;
+    w = nw;
+    return *this;
+  }
+
+  /// the nearest 8 bit pixel
+  inline operator CRGBW() const __attribute__((always_inline))
+  {
+    return CRGBW(round8(r), round8(g), round8(b), round8(w));
+  }
+
+  /// round a 16 bit channel to the nearest 8 bit value
+  static inline uint8_t round8(uint16_t v) __attribute__((always_inline))
+  {
+    return (v >= 0xFF80) ? 0xFF : ((v + 0x80) >> 8);
+  }
+};
+
+
+/// Flag for the EOrder values that also give the position of the white byte
+#define EORDER_W_FLAG 010000
 
 /// RGB orderings, used when instantiating controllers to determine what
 /// order the controller should send RGB data out in, RGB being the default
-/// ordering.
+/// ordering.  Each octal digit is the CRGBW byte sent in that position.  For
+/// RGBW strips, white is sent last, unless the order starts with W.
 enum EOrder {
   RGB=0012,
   RBG=0021,
   GRB=0102,
   GBR=0120,
   BRG=0201,
-  BGR=0210
+  BGR=0210,
+  WRGB=013012,
+  WRBG=013021,
+  WGRB=013102,
+  WGBR=013120,
+  WBRG=013201,
+  WBGR=013210
 };
 
 FASTLED_NAMESPACE_END
@@ -23,6 +23,91 @@ void set_max_power_in_volts_and_milliamps( uint8_t volts, uint32_t milliamps);
 /// Set the maximum power used in watts
 void set_max_power_in_milliwatts( uint32_t powerInmW);
 
+
+// Power profiles
+//
+// A power profile says how much power one led of a strip draws.  Controllers
+// without one use DefaultPowerProfile (5v SK6812 RGBW).
+//
+// Example:
+//     const CPowerProfile Strip12V = POWER_PROFILE_mA( 12, 6, 6, 6, 12, 1);
+//     FastLED.addLeds<...>(leds, NUM_LEDS).setPowerProfile( Strip12V);
+
+/// How much power one led draws, in milliwatts
+struct CPowerProfile {
+    uint16_t red_mW;    ///< the red channel at full brightness
+    uint16_t green_mW;  ///< the green channel at full brightness
+    uint16_t blue_mW;   ///< the blue channel at full brightness
+    uint16_t white_mW;  ///< the white channel at full brightness
+    uint16_t dark_mW;   ///< the led itself, with every channel off
+    uint8_t  volts;     ///< the supply voltage these figures are for
+};
+
+/// Build a power profile from the current each channel draws, in milliamps
+#define POWER_PROFILE_mA(volts, red, green, blue, white, dark) \
+    { (volts)*(red), (volts)*(green), (volts)*(blue), (volts)*(white), (volts)*(dark), (volts) }
+
+/// The power profile of controllers that have not been given one
+extern const CPowerProfile DefaultPowerProfile;
+
+
+// Power zones
+//
+// Each controller is on one of FASTLED_POWER_ZONES power zones, zone 0 unless
+// set with setPowerZone.  A zone is a group of controllers sharing a power
+// supply, and can be given a limit of its own; when one supply runs out,
+// only the leds on it are dimmed.  The limit set with
+// FastLED.setMaxPowerInMilliWatts still applies to all of them together.
+//
+// Example:
+//     FastLED.addLeds<...>(leds1, NUM_LEDS).setPowerZone( 1);
+//     FastLED.setZoneMaxPowerInVoltsAndMilliamps( 1, 5, 10000);
+
+#ifndef FASTLED_POWER_ZONES
+#define FASTLED_POWER_ZONES 4
+#endif
+
+/// Set the maximum power used by the controllers of one zone, in milliwatts (0 for no limit)
+void set_zone_max_power_in_milliwatts( uint8_t zone, uint32_t powerInmW);
+
+/// The brightness the controllers of a zone were given by the last call to
+/// calculate_max_brightness_for_power_mW( target_brightness, max_power_mW)
+uint8_t power_zone_brightness( uint8_t zone);
+
+
+// Power governor
+//
+// Without the governor, the brightness jumps to whatever keeps each frame
+// under the limit, so bright content visibly pumps the brightness.  The
+// governor instead limits the power averaged over window_ms, and moves the
+// brightness no faster than attack_ms (from full to off) and release_ms
+// (from off to full).  Short peaks can go over the limit, so leave some
+// margin to the power supply's rating.
+//
+// The average is exponentially weighted: each frame moves it dt/window_ms
+// of the way to that frame's draw, dt being the time since the last frame.
+// window_ms is its time constant: after a step in the draw, the average
+// has gone about 63% of the way in window_ms, and 95% in three times that.
+// A frame that comes window_ms or more after the last starts the average
+// over from its own draw.
+//
+// With max_temp_C set, the limits are also lowered once the chip is hotter
+// than that: by FASTLED_POWER_THERMAL_SPAN degrees over, they are down to a
+// quarter.  The chip temperature stands in for the temperature of the
+// enclosure, and is read once a second.
+//
+// Example:
+//     FastLED.setMaxPowerInVoltsAndMilliamps( 5, 4000);
+//     FastLED.setPowerGovernor( 2000, 100, 1000, 70);
+
+#ifndef FASTLED_POWER_THERMAL_SPAN
+#define FASTLED_POWER_THERMAL_SPAN 10
+#endif
+
+/// Set up the power governor; with all arguments 0 it is turned off
+void set_power_governor( uint16_t window_ms, uint16_t attack_ms, uint16_t release_ms, uint8_t max_temp_C);
+
+
 /// Select a ping with an led that will be flashed to indicate that power management
 /// is pulling down the brightness
 /// @deprecated - use FastLED.setMaxPowerInMilliWatts
@@ -56,7 +141,10 @@ void delay_at_max_brightness_for_power( uint16_t ms);
 /// calculate_unscaled_power_mW tells you how many milliwatts the current
 ///   LED data would draw at brightness = 255.
 ///
-uint32_t calculate_unscaled_power_mW( const CRGBW* ledbuffer, uint16_t numLeds);
+uint32_t calculate_unscaled_power_mW( const CRGBW* ledbuffer, uint16_t numLeds, const CPowerProfile& profile = DefaultPowerProfile);
+
+/// calculate_unscaled_power_mW for 16 bit led data
+uint32_t calculate_unscaled_power_mW( const CRGBW16* ledbuffer, uint16_t numLeds, const CPowerProfile& profile = DefaultPowerProfile);
 
 /// calculate_max_brightness_for_power_mW tells you the highest brightness
 ///   level you can use and still stay under the specified power budget for 
@@ -78,9 +166,42 @@ uint8_t calculate_max_brightness_for_power_vmA(const CRGBW* ledbuffer, uint16_t
 ///   level you can use and still stay under the specified power budget.  It
 ///   takes a 'target brightness' which is the brightness you'd ideally like
 ///   to use.  The result from this function will be no higher than the
-///   target_brightess you supply, but may be lower.
+///   target_brightess you supply, but may be lower.  With power zones or the
+///   governor in use, it is the highest brightness of any zone with a
+///   controller on it, and the brightness of each zone is left for
+///   power_zone_brightness.
 uint8_t  calculate_max_brightness_for_power_mW( uint8_t target_brightness, uint32_t max_power_mW);
 
+
+// Incremental power tracking
+//
+// Normally the power limit adds up every led on every show.  With tracking
+// on, it only adds up again the blocks of leds that have been reported as
+// changed.  The CRGBWSet operators and the fill, fade, blend and blur
+// functions in colorutils report their own changes; anything else that
+// writes to the leds (such as leds[i] = color) has to call
+// power_track_changed itself.
+//
+// Example:
+//     FastLED.addLeds<...>(leds, NUM_LEDS);
+//     set_power_tracking( true);
+//     ...
+//     leds[i] = CRGBW::Red;
+//     power_track_changed( &leds[i], 1);
+//
+// Define FASTLED_POWER_TRACK_VALIDATE as 1 to check the running sums against
+// a full count on every show; power_track_mismatches() counts the times they
+// were wrong (they are corrected each time).
+
+/// Turn incremental power tracking on or off.  Call it after adding the leds.
+void set_power_tracking( bool enable);
+
+/// Report that count leds starting at leds have been (or are about to be) changed
+void power_track_changed( const CRGBW* leds, int count);
+
+/// Number of times validation found the running sums out of date
+uint32_t power_track_mismatches();
+
 FASTLED_NAMESPACE_END
 ///@}
 // POWER_MGT_H
@@ -0,0 +1,102 @@
+#ifndef __INC_XYMAP_H
+#define __INC_XYMAP_H
+
+#include "FastLED.h"
+
+FASTLED_NAMESPACE_BEGIN
+
+///@file xymap.h
+/// mapping the x, y positions of a matrix of leds to indices in the led array
+
+/// Describes how a matrix is wired up out of a grid of identical panels, so that compile_xy_layout can turn it
+/// into a table for CXYMap.  Each panel is wired in rows of panelWidth leds (every other row running backwards if
+/// serpentine), and is mounted turned rotation quarter turns clockwise.  Panels are chained row by row, every
+/// other row of panels running backwards if panelSerpentine, with gap leds between one panel and the next that
+/// are not part of the matrix (such as the leds on a run of strip between two panels).
+struct CXYLayout {
+    uint16_t panelWidth;      ///< leds in each row of a panel, as wired
+    uint16_t panelHeight;     ///< rows in each panel, as wired
+    uint8_t panelsAcross;     ///< panels in each row of panels
+    uint8_t panelsDown;       ///< rows of panels
+    bool serpentine;          ///< every other row of a panel runs backwards
+    uint8_t rotation;         ///< quarter turns clockwise each panel is mounted at, 0-3
+    bool panelSerpentine;     ///< every other row of panels is chained backwards
+    uint16_t gap;             ///< leds in the chain between one panel and the next
+
+    CXYLayout(uint16_t panelWidth, uint16_t panelHeight, uint8_t panelsAcross = 1, uint8_t panelsDown = 1,
+              bool serpentine = false, uint8_t rotation = 0, bool panelSerpentine = false, uint16_t gap = 0)
+        : panelWidth(panelWidth), panelHeight(panelHeight), panelsAcross(panelsAcross), panelsDown(panelsDown),
+          serpentine(serpentine), rotation(rotation), panelSerpentine(panelSerpentine), gap(gap) {}
+
+    /// the width of the matrix, as mounted
+    uint16_t width() const { return panelsAcross * ((rotation & 1) ? panelHeight : panelWidth); }
+    /// the height of the matrix, as mounted
+    uint16_t height() const { return panelsDown * ((rotation & 1) ? panelWidth : panelHeight); }
+    /// the number of x, y positions in the matrix, and so of entries in its table
+    uint32_t size() const { return (uint32_t)width() * height(); }
+    /// the number of leds in the chain, gaps included
+    uint32_t numLeds() const {
+        uint16_t panels = panelsAcross * panelsDown;
+        return panels ? (uint32_t)panels * panelWidth * panelHeight + (uint32_t)(panels - 1) * gap : 0;
+    }
+};
+
+/// Compile a layout into table, which must have room for layout.size() entries.  This is meant to be done once at
+/// startup, or when the panels are rearranged; a CXYMap over the table picks up the new layout with no other
+/// changes.  The 16 bit version returns false, leaving the table alone, if the chain is too long for 16 bit indices.
+bool compile_xy_layout(const CXYLayout &layout, uint16_t *table);
+void compile_xy_layout(const CXYLayout &layout, uint32_t *table);
+
+/// Maps the x, y position of each led in a width by height matrix to its index in the led array, for the 2D
+/// functions in colorutils and noise.  Plain layouts (one row after the other) and serpentine layouts (every
+/// other row running backwards) are worked out as they are used; any other layout is given as a table of
+/// width * height indices, row by row, of 16 or 32 bits.  The table is not copied, so it has to outlive the map.
+class CXYMap {
+    uint16_t mWidth;
+    uint16_t mHeight;
+    bool mSerpentine;
+    const uint16_t *mIndex16;
+    const uint32_t *mIndex32;
+    uint32_t mNumLeds;
+
+public:
+    /// A plain or serpentine matrix
+    CXYMap(uint16_t width, uint16_t height, bool serpentine = false) : mWidth(width), mHeight(height), mSerpentine(serpentine), mIndex16(NULL), mIndex32(NULL), mNumLeds((uint32_t)width * height) {}
+
+    /// A matrix laid out by a table of 16 bit indices into an array of numLeds leds (width * height if 0)
+    CXYMap(uint16_t width, uint16_t height, const uint16_t *index, uint32_t numLeds = 0) : mWidth(width), mHeight(height), mSerpentine(false), mIndex16(index), mIndex32(NULL), mNumLeds(numLeds ? numLeds : (uint32_t)width * height) {}
+
+    /// A matrix laid out by a table of 32 bit indices into an array of numLeds leds (width * height if 0)
+    CXYMap(uint16_t width, uint16_t height, const uint32_t *index, uint32_t numLeds = 0) : mWidth(width), mHeight(height), mSerpentine(false), mIndex16(NULL), mIndex32(index), mNumLeds(numLeds ? numLeds : (uint32_t)width * height) {}
+
+    /// A matrix laid out by a table compiled from layout with compile_xy_layout
+    CXYMap(const CXYLayout &layout, const uint16_t *index) : mWidth(layout.width()), mHeight(layout.height()), mSerpentine(false), mIndex16(index), mIndex32(NULL), mNumLeds(layout.numLeds()) {}
+
+    /// A matrix laid out by a table compiled from layout with compile_xy_layout
+    CXYMap(const CXYLayout &layout, const uint32_t *index) : mWidth(layout.width()), mHeight(layout.height()), mSerpentine(false), mIndex16(NULL), mIndex32(index), mNumLeds(layout.numLeds()) {}
+
+    /// the width of the matrix
+    uint16_t width() const { return mWidth; }
+    /// the height of the matrix
+    uint16_t height() const { return mHeight; }
+    /// the number of x, y positions in the matrix
+    uint32_t size() const { return (uint32_t)mWidth * mHeight; }
+    /// the number of leds in the led array the map indexes into
+    uint32_t numLeds() const { return mNumLeds; }
+
+    /// the index in the led array of the led at x, y
+    inline uint32_t mapXY(uint16_t x, uint16_t y) const {
+        uint32_t i = (uint32_t)y * mWidth + x;
+        if(mIndex16) { return mIndex16[i]; }
+        if(mIndex32) { return mIndex32[i]; }
+        if(mSerpentine && (y & 1)) { return i + mWidth - 1 - 2 * x; }
+        return i;
+    }
+
+    /// the index in the led array of the led at x, y
+    inline uint32_t operator()(uint16_t x, uint16_t y) const { return mapXY(x, y); }
+};
+
+FASTLED_NAMESPACE_END
+
+#endif
@@ -523,7 +523,7 @@ uint8_t inoise8(uint16_t x) {
 //     return (v *mulby44.i)  + ((v * mulby44.f) >> 4);
 // }
 
-void fill_raw_noise8(uint8_t *pData, uint8_t num_points, uint8_t octaves, uint16_t x, int scale, uint16_t time) {
+void fill_raw_noise8(uint8_t *pData, uint16_t num_points, uint8_t octaves, uint16_t x, int scale, uint16_t time) {
   uint32_t _xx = x;
   uint32_t scx = scale;
   for(int o = 0; o < octaves; o++) {
@@ -536,7 +536,7 @@ void fill_raw_noise8(uint8_t *pData, uint8_t num_points, uint8_t octaves, uint16
   }
 }
 
-void fill_raw_noise16into8(uint8_t *pData, uint8_t num_points, uint8_t octaves, uint32_t x, int scale, uint32_t time) {
+void fill_raw_noise16into8(uint8_t *pData, uint16_t num_points, uint8_t octaves, uint32_t x, int scale, uint32_t time) {
   uint32_t _xx = x;
   uint32_t scx = scale;
   for(int o = 0; o < octaves; o++) {
@@ -661,15 +661,30 @@ void fill_raw_2dnoise16into8(uint8_t *pData, int width, int height, uint8_t octa
   fill_raw_2dnoise16into8(pData, width, height, octaves, q44(2,0), 171, 1, x, scalex, y, scaley, time);
 }
 
+// Room for the noise values of the fill functions, kept from one call to the next
+// rather than on the stack, which large matrices would overflow
+static uint8_t *gNoiseScratch = NULL;
+static uint32_t gNoiseScratchSize = 0;
+
+static uint8_t *noise_scratch(uint32_t size) {
+  if(size > gNoiseScratchSize) {
+    free(gNoiseScratch);
+    gNoiseScratch = (uint8_t*)malloc(size);
+    gNoiseScratchSize = gNoiseScratch ? size : 0;
+  }
+  if(gNoiseScratch) {
+    memset(gNoiseScratch,0,size);
+  }
+  return gNoiseScratch;
+}
+
 void fill_noise8(CRGBW *leds, int num_leds,
             uint8_t octaves, uint16_t x, int scale,
             uint8_t hue_octaves, uint16_t hue_x, int hue_scale,
             uint16_t time) {
-  uint8_t V[num_leds];
-  uint8_t H[num_leds];
-
-  memset(V,0,num_leds);
-  memset(H,0,num_leds);
+  uint8_t *V = noise_scratch(2 * num_leds);
+  if(!V) { return; }
+  uint8_t *H = V + num_leds;
 
   fill_raw_noise8(V,num_leds,octaves,x,scale,time);
   fill_raw_noise8(H,num_leds,hue_octaves,hue_x,hue_scale,time);
@@ -677,17 +692,16 @@ void fill_noise8(CRGBW *leds, int num_leds,
   for(int i = 0; i < num_leds; i++) {
     leds[i] = CHSV(H[i],255,V[i]);
   }
+  power_track_changed(leds, num_leds);
 }
 
 void fill_noise16(CRGBW *leds, int num_leds,
             uint8_t octaves, uint16_t x, int scale,
             uint8_t hue_octaves, uint16_t hue_x, int hue_scale,
             uint16_t time, uint8_t hue_shift) {
-  uint8_t V[num_leds];
-  uint8_t H[num_leds];
-
-  memset(V,0,num_leds);
-  memset(H,0,num_leds);
+  uint8_t *V = noise_scratch(2 * num_leds);
+  if(!V) { return; }
+  uint8_t *H = V + num_leds;
 
   fill_raw_noise16into8(V,num_leds,octaves,x,scale,time);
   fill_raw_noise8(H,num_leds,hue_octaves,hue_x,hue_scale,time);
@@ -695,54 +709,61 @@ void fill_noise16(CRGBW *leds, int num_leds,
   for(int i = 0; i < num_leds; i++) {
     leds[i] = CHSV(H[i] + hue_shift,255,V[i]);
   }
+  power_track_changed(leds, num_leds);
 }
 
-void fill_2dnoise8(CRGBW *leds, int width, int height, bool serpentine,
+void fill_2dnoise8(CRGBW *leds, const CXYMap &map,
             uint8_t octaves, uint16_t x, int xscale, uint16_t y, int yscale, uint16_t time,
             uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time,bool blend) {
-  uint8_t V[height][width];
-  uint8_t H[height][width];
-
-  memset(V,0,height*width);
-  memset(H,0,height*width);
+  int width = map.width();
+  int height = map.height();
+  uint8_t *V = noise_scratch(2 * map.size());
+  if(!V) { return; }
+  uint8_t *H = V + map.size();
 
-  fill_raw_2dnoise8((uint8_t*)V,width,height,octaves,x,xscale,y,yscale,time);
-  fill_raw_2dnoise8((uint8_t*)H,width,height,hue_octaves,hue_x,hue_xscale,hue_y,hue_yscale,hue_time);
+  fill_raw_2dnoise8(V,width,height,octaves,x,xscale,y,yscale,time);
+  fill_raw_2dnoise8(H,width,height,hue_octaves,hue_x,hue_xscale,hue_y,hue_yscale,hue_time);
 
   int w1 = width-1;
   int h1 = height-1;
   for(int i = 0; i < height; i++) {
-    int wb = i*width;
+    const uint8_t *pV = V + (uint32_t)i*width;
+    const uint8_t *pH = H + (uint32_t)(h1-i)*width + w1;
     for(int j = 0; j < width; j++) {
-      CRGBW led(CHSV(H[h1-i][w1-j],255,V[i][j]));
+      CRGBW led(CHSV(pH[-j],255,pV[j]));
 
-      int pos = j;
-      if(serpentine && (i & 0x1)) {
-        pos = w1-j;
-      }
+      uint32_t pos = map.mapXY(j,i);
 
       if(blend) {
-        leds[wb+pos] >>= 1; leds[wb+pos] += (led>>=1);
+        leds[pos] >>= 1; leds[pos] += (led>>=1);
       } else {
-        leds[wb+pos] = led;
+        leds[pos] = led;
       }
     }
   }
+  power_track_changed(leds, map.numLeds());
 }
 
-void fill_2dnoise16(CRGBW *leds, int width, int height, bool serpentine,
+void fill_2dnoise8(CRGBW *leds, int width, int height, bool serpentine,
+            uint8_t octaves, uint16_t x, int xscale, uint16_t y, int yscale, uint16_t time,
+            uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time,bool blend) {
+  fill_2dnoise8(leds, CXYMap(width, height, serpentine), octaves, x, xscale, y, yscale, time,
+                hue_octaves, hue_x, hue_xscale, hue_y, hue_yscale, hue_time, blend);
+}
+
+void fill_2dnoise16(CRGBW *leds, const CXYMap &map,
             uint8_t octaves, uint32_t x, int xscale, uint32_t y, int yscale, uint32_t time,
             uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time, bool blend, uint16_t hue_shift) {
-  uint8_t V[height][width];
-  uint8_t H[height][width];
-
-  memset(V,0,height*width);
-  memset(H,0,height*width);
+  int width = map.width();
+  int height = map.height();
+  uint8_t *V = noise_scratch(2 * map.size());
+  if(!V) { return; }
+  uint8_t *H = V + map.size();
 
-  fill_raw_2dnoise16into8((uint8_t*)V,width,height,octaves,q44(2,0),171,1,x,xscale,y,yscale,time);
-  // fill_raw_2dnoise16into8((uint8_t*)V,width,height,octaves,x,xscale,y,yscale,time);
-  // fill_raw_2dnoise8((uint8_t*)V,width,height,hue_octaves,x,xscale,y,yscale,time);
-  fill_raw_2dnoise8((uint8_t*)H,width,height,hue_octaves,hue_x,hue_xscale,hue_y,hue_yscale,hue_time);
+  fill_raw_2dnoise16into8(V,width,height,octaves,q44(2,0),171,1,x,xscale,y,yscale,time);
+  // fill_raw_2dnoise16into8(V,width,height,octaves,x,xscale,y,yscale,time);
+  // fill_raw_2dnoise8(V,width,height,hue_octaves,x,xscale,y,yscale,time);
+  fill_raw_2dnoise8(H,width,height,hue_octaves,hue_x,hue_xscale,hue_y,hue_yscale,hue_time);
 
 
   int w1 = width-1;
@@ -750,22 +771,28 @@ void fill_2dnoise16(CRGBW *leds, int width, int height, bool serpentine,
   hue_shift >>= 8;
 
   for(int i = 0; i < height; i++) {
-    int wb = i*width;
+    const uint8_t *pV = V + (uint32_t)i*width;
+    const uint8_t *pH = H + (uint32_t)(h1-i)*width + w1;
     for(int j = 0; j < width; j++) {
-      CRGBW led(CHSV(hue_shift + (H[h1-i][w1-j]),196,V[i][j]));
+      CRGBW led(CHSV(hue_shift + (pH[-j]),196,pV[j]));
 
-      int pos = j;
-      if(serpentine && (i & 0x1)) {
-        pos = w1-j;
-      }
+      uint32_t pos = map.mapXY(j,i);
 
       if(blend) {
-        leds[wb+pos] >>= 1; leds[wb+pos] += (led>>=1);
+        leds[pos] >>= 1; leds[pos] += (led>>=1);
       } else {
-        leds[wb+pos] = led;
+        leds[pos] = led;
       }
     }
   }
+  power_track_changed(leds, map.numLeds());
+}
+
+void fill_2dnoise16(CRGBW *leds, int width, int height, bool serpentine,
+            uint8_t octaves, uint32_t x, int xscale, uint32_t y, int yscale, uint32_t time,
+            uint8_t hue_octaves, uint16_t hue_x, int hue_xscale, uint16_t hue_y, uint16_t hue_yscale,uint16_t hue_time, bool blend, uint16_t hue_shift) {
+  fill_2dnoise16(leds, CXYMap(width, height, serpentine), octaves, x, xscale, y, yscale, time,
+                 hue_octaves, hue_x, hue_xscale, hue_y, hue_yscale, hue_time, blend, hue_shift);
 }
 
 FASTLED_NAMESPACE_END
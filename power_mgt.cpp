@@ -18,23 +18,23 @@ FASTLED_NAMESPACE_BEGIN
 // However, this is good enough for most cases, and almost certainly better
 // than no power management at all.
 //
-// You're welcome to adjust these values as needed; there may eventually be an API
-// for changing these on the fly, but it saves codespace and RAM to have them
-// be compile-time constants.
-
-static const uint8_t gRed_mW   = 16 * 5; // 16mA @ 5v = 80mW
-static const uint8_t gGreen_mW = 11 * 5; // 11mA @ 5v = 55mW
-static const uint8_t gBlue_mW  = 15 * 5; // 15mA @ 5v = 75mW
-static const uint8_t gDark_mW  =  1 * 5; //  1mA @ 5v =  5mW
+// You're welcome to adjust these values as needed, or to give a controller
+// a profile of its own with setPowerProfile.
+
+const CPowerProfile DefaultPowerProfile = {
+    16 * 5, // red:   16mA @ 5v = 80mW
+    11 * 5, // green: 11mA @ 5v = 55mW
+    15 * 5, // blue:  15mA @ 5v = 75mW
+    20 * 5, // white: 20mA @ 5v = 100mW (SK6812 RGBW)
+     1 * 5, // dark:   1mA @ 5v =  5mW
+    5
+};
 
 // Alternate calibration by RAtkins via pre-PSU wattage measurments;
 // these are all probably about 20%-25% too high due to PSU heat losses,
 // but if you're measuring wattage on the PSU input side, this may
-// be a better set of calibrations.  (WS2812B)
-//  static const uint8_t gRed_mW   = 100;
-//  static const uint8_t gGreen_mW =  48;
-//  static const uint8_t gBlue_mW  = 100;
-//  static const uint8_t gDark_mW  =  12;
+// be a better set of calibrations.  (WS2812B, no white channel)
+//  const CPowerProfile WS2812B_PSU_Profile = { 100, 48, 100, 0, 12, 5 };
 
 
 #define POWER_LED 1
@@ -47,35 +47,351 @@ static const uint8_t gMCU_mW  =  25 * 5; // 25mA @ 5v = 125 mW
 static uint8_t  gMaxPowerIndicatorLEDPinNumber = 0; // default = Arduino onboard LED pin.  set to zero to skip this.
 
 
-uint32_t calculate_unscaled_power_mW( const CRGBW* ledbuffer, uint16_t numLeds ) //25354
+// sum * mW / 256, without running out of 32 bits
+static inline uint32_t scale_sum_mW( uint32_t sum, uint16_t mW)
 {
-    uint32_t red32 = 0, green32 = 0, blue32 = 0;
-    const CRGBW* firstled = &(ledbuffer[0]);
-    uint8_t* p = (uint8_t*)(firstled);
+    return (sum >> 8) * mW + (((sum & 0xFF) * mW) >> 8);
+}
+
+static uint32_t power_mW_from_sums( uint32_t red32, uint32_t green32, uint32_t blue32, uint32_t white32, uint16_t numLeds, const CPowerProfile& profile)
+{
+    return scale_sum_mW( red32,   profile.red_mW)
+         + scale_sum_mW( green32, profile.green_mW)
+         + scale_sum_mW( blue32,  profile.blue_mW)
+         + scale_sum_mW( white32, profile.white_mW)
+         + ((uint32_t)profile.dark_mW * numLeds);
+}
+
+// Add up each channel of numLeds leds into sums[0..3] (r, g, b, w)
+static void add_channel_sums( const CRGBW* ledbuffer, uint16_t numLeds, uint32_t* sums)
+{
+    uint32_t red32 = 0, green32 = 0, blue32 = 0, white32 = 0;
+    const uint8_t* p = (const uint8_t*)ledbuffer;
+    bool aligned = (((uintptr_t)p) & 3) == 0;
 
     uint16_t count = numLeds;
 
-    // This loop might benefit from an AVR assembly version -MEK
+    // Each led is one 32 bit word. Red and blue are summed together in
+    // the two 16 bit halves of one word, green and white in another, so
+    // four channels take two adds. A half holds the sum of 257 full
+    // channels, so the halves are emptied every 256 leds.
     while( count) {
-        red32   += *p++;
-        green32 += *p++;
-        blue32  += *p++;
-        count--;
+        uint16_t n = (count > 256) ? 256 : count;
+        count -= n;
+
+        uint32_t rb = 0, gw = 0;
+        while( n--) {
+            uint32_t x;
+            if( aligned) {
+                x = *(const uint32_t*)p;
+            } else {
+                x = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+            }
+            p += 4;
+            rb += x & 0x00FF00FF;
+            gw += (x >> 8) & 0x00FF00FF;
+        }
+
+        red32   += rb & 0xFFFF;
+        blue32  += rb >> 16;
+        green32 += gw & 0xFFFF;
+        white32 += gw >> 16;
+    }
+
+    sums[0] += red32;
+    sums[1] += green32;
+    sums[2] += blue32;
+    sums[3] += white32;
+}
+
+uint32_t calculate_unscaled_power_mW( const CRGBW* ledbuffer, uint16_t numLeds, const CPowerProfile& profile ) //25354
+{
+    uint32_t sums[4] = { 0, 0, 0, 0 };
+    add_channel_sums( ledbuffer, numLeds, sums);
+    return power_mW_from_sums( sums[0], sums[1], sums[2], sums[3], numLeds, profile);
+}
+
+uint32_t calculate_unscaled_power_mW( const CRGBW16* ledbuffer, uint16_t numLeds, const CPowerProfile& profile )
+{
+    uint32_t red32 = 0, green32 = 0, blue32 = 0, white32 = 0;
+
+    for( uint16_t i = 0; i < numLeds; i++) {
+        red32   += ledbuffer[i].r >> 8;
+        green32 += ledbuffer[i].g >> 8;
+        blue32  += ledbuffer[i].b >> 8;
+        white32 += ledbuffer[i].w >> 8;
+    }
+
+    return power_mW_from_sums( red32, green32, blue32, white32, numLeds, profile);
+}
+
+static const CPowerProfile& power_profile( CLEDController* pController)
+{
+    return pController->getPowerProfile() ? *pController->getPowerProfile() : DefaultPowerProfile;
+}
+
+
+//// INCREMENTAL POWER TRACKING
+
+// With tracking on, each controller's leds are split into blocks, and the
+// channel sums of every block are kept, along with their totals. Writes
+// reported through power_track_changed() mark blocks as changed, and only
+// those are added up again at the next show.
+
+#ifndef FASTLED_POWER_TRACK_BLOCK
+#define FASTLED_POWER_TRACK_BLOCK 32
+#endif
+
+// -- A block's channel sums are 16 bits
+#if (FASTLED_POWER_TRACK_BLOCK < 1) || (FASTLED_POWER_TRACK_BLOCK * 255 > 65535)
+#error "FASTLED_POWER_TRACK_BLOCK must be from 1 to 257"
+#endif
+
+// Check the running sums against a full rescan on every show
+#ifndef FASTLED_POWER_TRACK_VALIDATE
+#define FASTLED_POWER_TRACK_VALIDATE 0
+#endif
+
+struct PowerTrack {
+    PowerTrack*     next;
+    CLEDController* controller;
+    const CRGBW*    leds;
+    uint16_t        numLeds;
+    uint16_t        numBlocks;
+    uint32_t        sums[4];
+    uint16_t      (*blockSums)[4];
+    uint8_t*        changed;
+};
+
+static PowerTrack* gPowerTracks = NULL;
+static bool gPowerTracking = false;
+static uint32_t gPowerTrackMismatches = 0;
+
+static PowerTrack* power_track_for( CLEDController* pController)
+{
+    for( PowerTrack* t = gPowerTracks; t; t = t->next) {
+        if( t->controller == pController) return t;
+    }
+    return NULL;
+}
+
+void set_power_tracking( bool enable)
+{
+    gPowerTracking = enable;
+    if( !enable) return;
+
+    // -- Changes made while tracking was off were not reported
+    for( PowerTrack* t = gPowerTracks; t; t = t->next) {
+        memset( t->changed, 1, t->numBlocks);
+    }
+
+    CLEDController *pCur = CLEDController::head();
+    while(pCur) {
+        if( pCur->leds() && !power_track_for( pCur)) {
+            uint16_t numBlocks = (pCur->size() + FASTLED_POWER_TRACK_BLOCK - 1) / FASTLED_POWER_TRACK_BLOCK;
+            PowerTrack* t = (PowerTrack*)malloc( sizeof(PowerTrack) + numBlocks * (sizeof(uint16_t[4]) + 1));
+            if( t) {
+                t->controller = pCur;
+                t->leds = pCur->leds();
+                t->numLeds = pCur->size();
+                t->numBlocks = numBlocks;
+                t->sums[0] = t->sums[1] = t->sums[2] = t->sums[3] = 0;
+                t->blockSums = (uint16_t(*)[4])(t + 1);
+                t->changed = (uint8_t*)(t->blockSums + numBlocks);
+                memset( t->blockSums, 0, numBlocks * sizeof(uint16_t[4]));
+                memset( t->changed, 1, numBlocks);
+                t->next = gPowerTracks;
+                gPowerTracks = t;
+            }
+        }
+        pCur = pCur->next();
+    }
+}
+
+void power_track_changed( const CRGBW* leds, int count)
+{
+    if( !gPowerTracking) return;
+
+    for( PowerTrack* t = gPowerTracks; t; t = t->next) {
+        int first = leds - t->leds;
+        int last = first + count;
+        if( last <= 0 || first >= t->numLeds) continue;
+        if( first < 0) first = 0;
+        if( last > t->numLeds) last = t->numLeds;
+
+        for( int b = first / FASTLED_POWER_TRACK_BLOCK; b <= (last - 1) / FASTLED_POWER_TRACK_BLOCK; b++) {
+            t->changed[b] = 1;
+        }
+    }
+}
+
+uint32_t power_track_mismatches()
+{
+    return gPowerTrackMismatches;
+}
+
+// Bring the sums up to date by adding up the changed blocks again
+static void power_track_update( PowerTrack* t)
+{
+    for( uint16_t b = 0; b < t->numBlocks; b++) {
+        if( !t->changed[b]) continue;
+        t->changed[b] = 0;
+
+        uint16_t first = b * FASTLED_POWER_TRACK_BLOCK;
+        uint16_t n = t->numLeds - first;
+        if( n > FASTLED_POWER_TRACK_BLOCK) n = FASTLED_POWER_TRACK_BLOCK;
+
+        uint32_t sums[4] = { 0, 0, 0, 0 };
+        add_channel_sums( t->leds + first, n, sums);
+        for( int i = 0; i < 4; i++) {
+            t->sums[i] += sums[i] - t->blockSums[b][i];
+            t->blockSums[b][i] = sums[i];
+        }
+    }
+}
+
+static uint32_t power_track_mW( PowerTrack* t)
+{
+    // -- Pointed at other leds since tracking started: start over
+    if( t->leds != t->controller->leds() || t->numLeds != t->controller->size()) {
+        return calculate_unscaled_power_mW( t->controller->leds(), t->controller->size(), power_profile( t->controller));
+    }
+
+    power_track_update( t);
+
+#if FASTLED_POWER_TRACK_VALIDATE == 1
+    uint32_t sums[4] = { 0, 0, 0, 0 };
+    add_channel_sums( t->leds, t->numLeds, sums);
+    if( memcmp( sums, t->sums, sizeof(sums))) {
+        // -- Something changed the leds without telling us
+        gPowerTrackMismatches++;
+        memset( t->changed, 1, t->numBlocks);
+        power_track_update( t);
     }
+#endif
+
+    return power_mW_from_sums( t->sums[0], t->sums[1], t->sums[2], t->sums[3], t->numLeds, power_profile( t->controller));
+}
+
+// Power draw of a controller's leds at brightness 255
+static uint32_t controller_unscaled_power_mW( CLEDController* pCur)
+{
+    PowerTrack* t = gPowerTracking ? power_track_for( pCur) : NULL;
+    if(t) {
+        return power_track_mW( t);
+    } else if(pCur->leds16()) {
+        return calculate_unscaled_power_mW( pCur->leds16(), pCur->size(), power_profile( pCur));
+    } else {
+        return calculate_unscaled_power_mW( pCur->leds(), pCur->size(), power_profile( pCur));
+    }
+}
+
 
-    red32   *= gRed_mW;
-    green32 *= gGreen_mW;
-    blue32  *= gBlue_mW;
+//// POWER ZONES AND GOVERNOR
 
-    red32   >>= 8;
-    green32 >>= 8;
-    blue32  >>= 8;
+static uint32_t gZoneMax_mW[FASTLED_POWER_ZONES];       // 0 = no limit
+static uint8_t  gZoneBrightness[FASTLED_POWER_ZONES];
 
-    uint32_t total = red32 + green32 + blue32 + (gDark_mW * numLeds);
+struct PowerGovernor {
+    uint16_t window_ms;
+    uint16_t attack_ms;
+    uint16_t release_ms;
+    uint8_t  max_temp_C;
+    bool     started;
+    uint16_t thermal;                           // the limits are scaled by thermal/256
+    uint32_t lastFrame;
+    uint32_t lastTemperature;
+    uint32_t average_mW[FASTLED_POWER_ZONES];   // draw at brightness 255, averaged over the window
+    uint16_t level[FASTLED_POWER_ZONES];        // brightness limit of each zone, 8.8 fixed point
+};
 
-    return total;
+static PowerGovernor gGovernor;
+static bool gGoverned = false;
+
+static inline uint8_t power_zone_index( CLEDController* pController)
+{
+    return (pController->getPowerZone() < FASTLED_POWER_ZONES) ? pController->getPowerZone() : 0;
+}
+
+void set_zone_max_power_in_milliwatts( uint8_t zone, uint32_t powerInmW)
+{
+    if( zone < FASTLED_POWER_ZONES) {
+        gZoneMax_mW[zone] = powerInmW;
+    }
 }
 
+uint8_t power_zone_brightness( uint8_t zone)
+{
+    return gZoneBrightness[ (zone < FASTLED_POWER_ZONES) ? zone : 0];
+}
+
+void set_power_governor( uint16_t window_ms, uint16_t attack_ms, uint16_t release_ms, uint8_t max_temp_C)
+{
+    gGovernor.window_ms = window_ms;
+    gGovernor.attack_ms = attack_ms;
+    gGovernor.release_ms = release_ms;
+    gGovernor.max_temp_C = max_temp_C;
+    gGovernor.started = false;
+    gGovernor.thermal = 256;
+    gGoverned = window_ms || attack_ms || release_ms || max_temp_C;
+}
+
+// Lower the limits once the chip is hotter than max_temp_C
+static void governor_read_temperature( uint32_t now)
+{
+    if( !gGovernor.max_temp_C) return;
+    if( gGovernor.started && (now - gGovernor.lastTemperature) < 1000) return;
+    gGovernor.lastTemperature = now;
+
+    int over = (int)temperatureRead() - gGovernor.max_temp_C;
+    if( over <= 0) {
+        gGovernor.thermal = 256;
+    } else if( over >= FASTLED_POWER_THERMAL_SPAN) {
+        gGovernor.thermal = 64;
+    } else {
+        gGovernor.thermal = 256 - (192 * over) / FASTLED_POWER_THERMAL_SPAN;
+    }
+}
+
+// Move the average of a zone's draw towards this frame's draw, dt ms on
+static uint32_t governor_average( uint8_t zone, uint32_t unscaled_mW, uint32_t dt)
+{
+    uint32_t & average = gGovernor.average_mW[zone];
+    if( !gGovernor.started || dt >= gGovernor.window_ms) {
+        average = unscaled_mW;
+    } else {
+        average += ((int64_t)unscaled_mW - (int64_t)average) * dt / gGovernor.window_ms;
+    }
+    return average;
+}
+
+// Move the brightness limit of a zone towards limit, no faster than the attack and release times allow
+static uint8_t governor_slew( uint8_t zone, uint8_t limit, uint32_t dt)
+{
+    uint16_t & level = gGovernor.level[zone];
+    uint16_t want = limit << 8;
+    if( !gGovernor.started) {
+        level = want;
+    } else if( want < level) {
+        uint32_t step = gGovernor.attack_ms ? (0xFF00UL * dt) / gGovernor.attack_ms : 0xFF00;
+        level = ((uint32_t)(level - want) > step) ? level - step : want;
+    } else {
+        uint32_t step = gGovernor.release_ms ? (0xFF00UL * dt) / gGovernor.release_ms : 0xFF00;
+        level = ((uint32_t)(want - level) > step) ? level + step : want;
+    }
+    return level >> 8;
+}
+
+// The highest brightness, up to target_brightness, at which leds that draw
+// unscaled_mW at brightness 255 stay under max_power_mW
+static uint8_t brightness_for_power( uint8_t target_brightness, uint32_t unscaled_mW, uint32_t max_power_mW)
+{
+    uint32_t requested_power_mW = ((uint32_t)unscaled_mW * target_brightness) / 256;
+    if( requested_power_mW < max_power_mW) {
+        return target_brightness;
+    }
+    return (uint32_t)((uint8_t)(target_brightness) * (uint32_t)(max_power_mW)) / ((uint32_t)(requested_power_mW));
+}
 
 uint8_t calculate_max_brightness_for_power_vmA(const CRGBW* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_V, uint32_t max_power_mA) {
 	return calculate_max_brightness_for_power_mW(ledbuffer, numLeds, target_brightness, max_power_V * max_power_mA);
@@ -84,75 +400,109 @@ uint8_t calculate_max_brightness_for_power_vmA(const CRGBW* ledbuffer, uint16_t
 uint8_t calculate_max_brightness_for_power_mW(const CRGBW* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_mW) {
  	uint32_t total_mW = calculate_unscaled_power_mW( ledbuffer, numLeds);
 
-	uint32_t requested_power_mW = ((uint32_t)total_mW * target_brightness) / 256;
-
-	uint8_t recommended_brightness = target_brightness;
-	if(requested_power_mW > max_power_mW) { 
-    		recommended_brightness = (uint32_t)((uint8_t)(target_brightness) * (uint32_t)(max_power_mW)) / ((uint32_t)(requested_power_mW));
-	}
-
-	return recommended_brightness;
+	return brightness_for_power( target_brightness, total_mW, max_power_mW);
 }
 
 // sets brightness to
 //  - no more than target_brightness
 //  - no more than max_mW milliwatts
+// and the brightness of each power zone to
+//  - no more than that
+//  - no more than the zone's own limit
 uint8_t calculate_max_brightness_for_power_mW( uint8_t target_brightness, uint32_t max_power_mW)
 {
-    uint32_t total_mW = gMCU_mW;
+    uint32_t zone_mW[FASTLED_POWER_ZONES];
+    bool zone_used[FASTLED_POWER_ZONES];
+    memset( zone_mW, 0, sizeof(zone_mW));
+    memset( zone_used, 0, sizeof(zone_used));
 
     CLEDController *pCur = CLEDController::head();
 	while(pCur) {
-        total_mW += calculate_unscaled_power_mW( pCur->leds(), pCur->size());
+        zone_mW[ power_zone_index( pCur)] += controller_unscaled_power_mW( pCur);
+        zone_used[ power_zone_index( pCur)] = true;
 		pCur = pCur->next();
 	}
 
+    // -- The governor works on averaged draws, and limits brightness 255;
+    //    target_brightness is applied after slewing, so it takes effect at once
+    uint32_t dt = 0;
+    uint8_t limit_brightness = target_brightness;
+    uint16_t thermal = 256;
+    if( gGoverned) {
+        uint32_t now = millis();
+        dt = gGovernor.started ? (now - gGovernor.lastFrame) : 0;
+        gGovernor.lastFrame = now;
+
+        governor_read_temperature( now);
+        thermal = gGovernor.thermal;
+        if( thermal < 256) {
+            max_power_mW = (max_power_mW >> 8) * thermal;
+        }
+
+        for( uint8_t z = 0; z < FASTLED_POWER_ZONES; z++) {
+            zone_mW[z] = governor_average( z, zone_mW[z], dt);
+        }
+        limit_brightness = 255;
+    }
+
+    uint32_t total_mW = gMCU_mW;
+    for( uint8_t z = 0; z < FASTLED_POWER_ZONES; z++) {
+        total_mW += zone_mW[z];
+    }
+
 #if POWER_DEBUG_PRINT == 1
     Serial.print("power demand at full brightness mW = ");
     Serial.println( total_mW);
-#endif
-
-    uint32_t requested_power_mW = ((uint32_t)total_mW * target_brightness) / 256;
-#if POWER_DEBUG_PRINT == 1
-    if( target_brightness != 255 ) {
-        Serial.print("power demand at scaled brightness mW = ");
-        Serial.println( requested_power_mW);
-    }
     Serial.print("power limit mW = ");
     Serial.println( max_power_mW);
 #endif
 
-    if( requested_power_mW < max_power_mW) {
-#if POWER_LED > 0
-        if( gMaxPowerIndicatorLEDPinNumber ) {
-            Pin(gMaxPowerIndicatorLEDPinNumber).lo(); // turn the LED off
+    uint8_t recommended_brightness = brightness_for_power( limit_brightness, total_mW, max_power_mW);
+
+    // -- Zones without controllers get a brightness too, but it is not
+    //    part of the result
+    uint8_t max_brightness = 0;
+    bool any_used = false;
+    bool limited = false;
+    for( uint8_t z = 0; z < FASTLED_POWER_ZONES; z++) {
+        uint8_t zone_brightness = recommended_brightness;
+        if( gZoneMax_mW[z]) {
+            uint32_t zone_max_mW = (thermal < 256) ? (gZoneMax_mW[z] >> 8) * thermal : gZoneMax_mW[z];
+            zone_brightness = brightness_for_power( zone_brightness, zone_mW[z], zone_max_mW);
         }
-#endif
-#if POWER_DEBUG_PRINT == 1
-        Serial.print("demand is under the limit");
-#endif
-        return target_brightness;
+        if( gGoverned) {
+            zone_brightness = governor_slew( z, zone_brightness, dt);
+            if( zone_brightness > target_brightness) zone_brightness = target_brightness;
+        }
+        gZoneBrightness[z] = zone_brightness;
+        if( !zone_used[z]) continue;
+        any_used = true;
+        if( zone_brightness < target_brightness) limited = true;
+        if( zone_brightness > max_brightness) max_brightness = zone_brightness;
     }
+    if( !any_used) {
+        max_brightness = (recommended_brightness < target_brightness) ? recommended_brightness : target_brightness;
+    }
+    gGovernor.started = gGoverned;
 
-    uint8_t recommended_brightness = (uint32_t)((uint8_t)(target_brightness) * (uint32_t)(max_power_mW)) / ((uint32_t)(requested_power_mW));
 #if POWER_DEBUG_PRINT == 1
     Serial.print("recommended brightness # = ");
-    Serial.println( recommended_brightness);
-
-    uint32_t resultant_power_mW = (total_mW * recommended_brightness) / 256;
-    Serial.print("resultant power demand mW = ");
-    Serial.println( resultant_power_mW);
-
+    Serial.println( max_brightness);
     Serial.println();
 #endif
 
 #if POWER_LED > 0
     if( gMaxPowerIndicatorLEDPinNumber ) {
-        Pin(gMaxPowerIndicatorLEDPinNumber).hi(); // turn the LED on
+        // turn the LED on while the brightness is being pulled down
+        if( limited) {
+            Pin(gMaxPowerIndicatorLEDPinNumber).hi();
+        } else {
+            Pin(gMaxPowerIndicatorLEDPinNumber).lo();
+        }
     }
 #endif
 
-    return recommended_brightness;
+    return max_brightness;
 }
 
 
@@ -0,0 +1,50 @@
+// Timing for the host benchmarks. Each benchmark is a program of its own
+// (bench_*.cpp, run by "make bench"): it times the cases it compares and
+// prints a line for each with bench_report(). Times are host nanoseconds,
+// so they say how the cases compare with each other, not how fast they
+// run on an ESP32.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// -- Results go here, so that the compiler cannot drop the work
+static volatile uint32_t gBenchSink;
+
+static inline uint64_t bench_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// -- Nanoseconds for one call of run(), the best of five rounds of at
+//    least 20 ms each
+template<typename F> static double bench_ns(F run)
+{
+    double best = 0;
+    for (int round = 0; round < 5; round++) {
+        uint64_t calls = 0;
+        uint64_t start = bench_now_ns();
+        uint64_t elapsed;
+        do {
+            run();
+            calls++;
+            elapsed = bench_now_ns() - start;
+        } while (elapsed < 20000000ULL);
+        double ns = (double)elapsed / calls;
+        if (round == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// -- One line of results: the time for one call, per item (pixel, byte,
+//    ...), and against a baseline time for the same work (0 for none)
+static inline double bench_report(const char * name, const char * item, uint32_t items, double ns, double baseline_ns)
+{
+    printf("%-40s %10.0f ns  %8.2f ns/%s", name, ns, ns / items, item);
+    if (baseline_ns > 0) printf("  %5.2fx", baseline_ns / ns);
+    printf("\n");
+    return ns;
+}
@@ -0,0 +1,62 @@
+// blur2d on a 512x512 matrix, through each kind of CXYMap, against
+// blurring the rows and then the columns; and on a 16x16 matrix through
+// the application's XY() against the same layout as a map, since small
+// matrices should be no slower for the maps
+
+#include <vector>
+#include "FastLED.h"
+#include "bench.h"
+
+#define BLUR 64
+
+// -- The XY() the XY-based 2D functions use: serpentine, 16 wide
+uint16_t XY(uint8_t x, uint8_t y) { return (y & 1) ? (uint16_t)y * 16 + 15 - x : (uint16_t)y * 16 + x; }
+
+static std::vector<CRGBW> gLeds(512 * 512);
+
+static void fill_random(uint32_t n)
+{
+    random16_set_seed(24);
+    for (uint32_t i = 0; i < n; i++) gLeds[i] = CRGBW(random8(), random8(), random8(), random8());
+}
+
+static double blur2d_ns(const CXYMap & map)
+{
+    return bench_ns([&map] {
+        blur2d(&gLeds[0], map, BLUR);
+        gBenchSink = gLeds[0].r;
+    });
+}
+
+int main()
+{
+    // -- 8x8 panels of 64x64, turned a quarter, serpentine both ways
+    CXYLayout layout(64, 64, 8, 8, true, 1, true);
+    std::vector<uint32_t> table32(layout.size());
+    compile_xy_layout(layout, &table32[0]);
+
+    fill_random(512 * 512);
+    CXYMap plain(512, 512);
+    double two_pass = bench_report("512x512 blurRows + blurColumns, plain", "pixel", 512 * 512, bench_ns([&plain] {
+        blurRows(&gLeds[0], plain, BLUR);
+        blurColumns(&gLeds[0], plain, BLUR);
+        gBenchSink = gLeds[0].r;
+    }), 0);
+    bench_report("512x512 blur2d, plain", "pixel", 512 * 512, blur2d_ns(plain), two_pass);
+    bench_report("512x512 blur2d, serpentine", "pixel", 512 * 512, blur2d_ns(CXYMap(512, 512, true)), two_pass);
+    bench_report("512x512 blur2d, 32 bit table", "pixel", 512 * 512, blur2d_ns(CXYMap(layout, &table32[0])), two_pass);
+
+    // -- The same layout as XY() above, called for each led, and as maps
+    CXYMap serpentine16(16, 16, true);
+    std::vector<uint16_t> table16(16 * 16);
+    for (uint16_t i = 0; i < 16 * 16; i++) table16[i] = serpentine16(i % 16, i / 16);
+
+    fill_random(16 * 16);
+    double by_xy = bench_report("16x16 blur2d, XY()", "pixel", 16 * 16, bench_ns([] {
+        blur2d(&gLeds[0], 16, 16, BLUR);
+        gBenchSink = gLeds[0].r;
+    }), 0);
+    bench_report("16x16 blur2d, serpentine", "pixel", 16 * 16, blur2d_ns(serpentine16), by_xy);
+    bench_report("16x16 blur2d, 16 bit table", "pixel", 16 * 16, blur2d_ns(CXYMap(16, 16, &table16[0])), by_xy);
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Preparing a frame for the wire: PixelController::loadAndScalePixels,
+// which scales, dithers and reorders whole pixels in packed 32-bit words,
+// against loadAndScale0..3 a byte at a time, for 1000 pixels. The packed
+// path is meant for the ESP32's 32-bit core, with no byte-wise saturating
+// add; a 64-bit host, which the compiler can vectorize the byte path for,
+// may not show the same gain.
+
+#include <vector>
+#include "FastLED.h"
+#include "bench.h"
+
+#define NUM 1000
+
+static std::vector<uint8_t> gLeds(4 * NUM);
+static std::vector<uint8_t> gOut(4 * NUM);
+static CRGBW gScale;
+
+template<EOrder RGB_ORDER, int BYTES> static void bytewise(uint8_t dither)
+{
+    PixelController<RGB_ORDER> pixels(&gLeds[0], NUM, gScale, dither);
+    uint8_t * p = &gOut[0];
+    while (pixels.has(1)) {
+        p[0] = pixels.loadAndScale0();
+        p[1] = pixels.loadAndScale1();
+        p[2] = pixels.loadAndScale2();
+        if (BYTES == 4) p[3] = pixels.loadAndScale3();
+        p += BYTES;
+        pixels.advanceData();
+        pixels.stepDithering();
+    }
+    gBenchSink = gOut[0];
+}
+
+template<EOrder RGB_ORDER, int BYTES> static void batched(uint8_t dither)
+{
+    PixelController<RGB_ORDER> pixels(&gLeds[0], NUM, gScale, dither);
+    pixels.template loadAndScalePixels<BYTES>(&gOut[0], NUM);
+    gBenchSink = gOut[0];
+}
+
+template<EOrder RGB_ORDER, int BYTES> static void compare(const char * name, uint8_t dither)
+{
+    char label[64];
+    snprintf(label, sizeof(label), "%s, byte at a time", name);
+    double base = bench_report(label, "pixel", NUM, bench_ns([=] { bytewise<RGB_ORDER, BYTES>(dither); }), 0);
+    snprintf(label, sizeof(label), "%s, packed", name);
+    bench_report(label, "pixel", NUM, bench_ns([=] { batched<RGB_ORDER, BYTES>(dither); }), base);
+}
+
+int main()
+{
+    random16_set_seed(3);
+    for (int i = 0; i < 4 * NUM; i++) gLeds[i] = random8();
+
+    // -- Brightness alone: the same scale for every channel
+    gScale = CRGBW(200, 200, 200, 200);
+    compare<RGB, 4>("RGBW", DISABLE_DITHER);
+    compare<RGB, 4>("RGBW dithered", BINARY_DITHER);
+    compare<GRB, 3>("GRB dithered", BINARY_DITHER);
+
+    // -- With color correction: a scale of its own for each channel
+    gScale = CRGBW(200, 180, 160, 140);
+    compare<RGB, 4>("RGBW corrected, dithered", BINARY_DITHER);
+    compare<GRB, 3>("GRB corrected, dithered", BINARY_DITHER);
+    return 0;
+}
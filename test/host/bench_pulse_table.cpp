@@ -0,0 +1,92 @@
+// Refilling the RMT buffer: a copy of eight items from the byte-to-pulse
+// table for each byte, against the bit-at-a-time loop it replaced, both
+// writing a frame of 1000 RGBW pixels into RMT memory a half buffer at a
+// time
+
+#include <vector>
+#include "FastLED.h"
+#include "bench.h"
+
+#define T1 NS(300)
+#define T2 NS(300)
+#define T3 NS(600)
+
+#define HALF  (32 * FASTLED_RMT_MEM_BLOCKS)
+#define BYTES (4 * 1000)
+
+static std::vector<uint8_t> gPixelData(BYTES);
+static uint32_t gZero;
+static uint32_t gOne;
+
+// -- The bit-at-a-time refill (before the table)
+static void refill_by_bit()
+{
+    volatile uint32_t * mem = RMT_CHANNEL_MEM(0);
+    int cur_pulse = 0;
+    int cur_byte = 0;
+    while (cur_byte < BYTES) {
+        int pulses = 0;
+        while (pulses < HALF && cur_byte < BYTES) {
+            uint32_t byteval = gPixelData[cur_byte++];
+            byteval <<= 24;
+            for (uint32_t j = 0; j < 8; j++) {
+                mem[cur_pulse] = (byteval & 0x80000000L) ? gOne : gZero;
+                byteval <<= 1;
+                cur_pulse++;
+            }
+            pulses += 8;
+        }
+        if (cur_pulse >= HALF * 2) cur_pulse = 0;
+    }
+}
+
+// -- The table refill (as in ClocklessController::fillHalfRMTBuffer)
+static void refill_from_table()
+{
+    const uint32_t * table = ClocklessRMTPulseTable<T1, T2, T3>::mPulses;
+    volatile uint32_t * mem = RMT_CHANNEL_MEM(0);
+    int cur_pulse = 0;
+    int cur_byte = 0;
+    while (cur_byte < BYTES) {
+        volatile uint32_t * dest = mem + cur_pulse;
+        int pulses = 0;
+        while (pulses < HALF && cur_byte < BYTES) {
+            const uint32_t * src = table + (gPixelData[cur_byte++] << 3);
+            dest[0] = src[0];
+            dest[1] = src[1];
+            dest[2] = src[2];
+            dest[3] = src[3];
+            dest[4] = src[4];
+            dest[5] = src[5];
+            dest[6] = src[6];
+            dest[7] = src[7];
+            dest += 8;
+            pulses += 8;
+        }
+        cur_pulse += pulses;
+        if (cur_pulse >= HALF * 2) cur_pulse = 0;
+    }
+}
+
+int main()
+{
+    rmt_item32_t zero, one;
+    one.level0 = 1;
+    one.duration0 = TO_RMT_CYCLES(T1 + T2);
+    one.level1 = 0;
+    one.duration1 = TO_RMT_CYCLES(T3);
+    zero.level0 = 1;
+    zero.duration0 = TO_RMT_CYCLES(T1);
+    zero.level1 = 0;
+    zero.duration1 = TO_RMT_CYCLES(T2 + T3);
+    gZero = zero.val;
+    gOne = one.val;
+    ClocklessRMTPulseTable<T1, T2, T3>::build(gZero, gOne);
+
+    random16_set_seed(1);
+    for (int i = 0; i < BYTES; i++) gPixelData[i] = random8();
+
+    double by_bit = bench_report("refill, bit at a time", "byte", BYTES, bench_ns(refill_by_bit), 0);
+    bench_report("refill, from the pulse table", "byte", BYTES, bench_ns(refill_from_table), by_bit);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Scaling CRGBW arrays: nscale8 and nscale8_video a whole pixel at a time,
+// against the loops over CRGBW::nscale8 and CRGBW::nscale8_video they
+// replaced, on 1000, 10000 and 100000 pixels
+//
+// Each call starts from the same random pixels, copied in first, so that
+// the pixels do not all fade to black as the rounds go on; the time of the
+// copy on its own is taken off each result
+
+#include <string.h>
+#include <vector>
+#include "FastLED.h"
+#include "bench.h"
+
+#define MOST  100000
+#define SCALE 200
+
+static std::vector<CRGBW> gSource(MOST);
+static std::vector<CRGBW> gLeds(MOST);
+
+// -- The loops before (as in colorutils.cpp)
+static void nscale8_by_pixel(CRGBW * leds, uint16_t num_leds, uint8_t scale)
+{
+    for (uint16_t i = 0; i < num_leds; i++) leds[i].nscale8(scale);
+}
+
+static void nscale8_video_by_pixel(CRGBW * leds, uint16_t num_leds, uint8_t scale)
+{
+    for (uint16_t i = 0; i < num_leds; i++) leds[i].nscale8_video(scale);
+}
+
+// -- A fresh copy of the first n pixels, scaled; the arrays take a 16 bit
+//    count, so longer ones go in parts
+template<void (*SCALE_ARRAY)(CRGBW *, uint16_t, uint8_t)> static double scale_ns(uint32_t n, double copy_ns)
+{
+    return bench_ns([n] {
+        memcpy((void *)&gLeds[0], &gSource[0], n * sizeof(CRGBW));
+        for (uint32_t i = 0; i < n; i += 50000) {
+            SCALE_ARRAY(&gLeds[i], (n - i < 50000) ? n - i : 50000, SCALE);
+        }
+        gBenchSink = gLeds[n - 1].r;
+    }) - copy_ns;
+}
+
+int main()
+{
+    random16_set_seed(21);
+    for (int i = 0; i < MOST; i++) gSource[i] = CRGBW(random8(), random8(), random8(), random8());
+
+    static const uint32_t sizes[] = { 1000, 10000, 100000 };
+    for (int s = 0; s < 3; s++) {
+        uint32_t n = sizes[s];
+        double copy_ns = bench_ns([n] {
+            memcpy((void *)&gLeds[0], &gSource[0], n * sizeof(CRGBW));
+            gBenchSink = gLeds[n - 1].r;
+        });
+
+        char name[64];
+        snprintf(name, sizeof(name), "nscale8, by pixel, %u", n);
+        double by_pixel = bench_report(name, "pixel", n, scale_ns<nscale8_by_pixel>(n, copy_ns), 0);
+        snprintf(name, sizeof(name), "nscale8, packed, %u", n);
+        bench_report(name, "pixel", n, scale_ns<nscale8>(n, copy_ns), by_pixel);
+
+        snprintf(name, sizeof(name), "nscale8_video, by pixel, %u", n);
+        by_pixel = bench_report(name, "pixel", n, scale_ns<nscale8_video_by_pixel>(n, copy_ns), 0);
+        snprintf(name, sizeof(name), "nscale8_video, packed, %u", n);
+        bench_report(name, "pixel", n, scale_ns<nscale8_video>(n, copy_ns), by_pixel);
+    }
+    return 0;
+}
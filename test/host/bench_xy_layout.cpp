@@ -0,0 +1,74 @@
+// Finding each led of a panel wall: a lookup in the table compiled by
+// compile_xy_layout, against an XY() that works the index out from the
+// layout for every led (a call per pixel, as the XY() hook was), both
+// writing every led of a 128x128 wall of 16x16 panels a row at a time
+
+#include <vector>
+#include "FastLED.h"
+#include "bench.h"
+
+// -- 8x8 panels of 16x16, turned a quarter, serpentine both ways, with 3
+//    leds between panels
+static const CXYLayout gLayout(16, 16, 8, 8, true, 1, true, 3);
+static std::vector<CRGBW> gLeds(gLayout.numLeds());
+
+// -- The panel x, y is on, where it is in the chain, and where x, y is in
+//    the panel as it was wired, turning it back a quarter at a time
+static __attribute__((noinline)) uint32_t walk_xy(uint16_t x, uint16_t y)
+{
+    uint16_t pw = gLayout.panelWidth;
+    uint16_t ph = gLayout.panelHeight;
+    uint16_t w = (gLayout.rotation & 1) ? ph : pw;
+    uint16_t h = (gLayout.rotation & 1) ? pw : ph;
+
+    uint16_t px = x / w, py = y / h;
+    if (gLayout.panelSerpentine && (py & 1)) px = gLayout.panelsAcross - 1 - px;
+    uint32_t k = (uint32_t)py * gLayout.panelsAcross + px;
+
+    int u = x % w, v = y % h;
+    for (int r = 0; r < (gLayout.rotation & 3); r++) {
+        int turned = w - 1 - u;
+        u = v;
+        v = turned;
+        std::swap(w, h);
+    }
+    if (gLayout.serpentine && (v & 1)) u = pw - 1 - u;
+    return k * ((uint32_t)pw * ph + gLayout.gap) + (uint32_t)v * pw + u;
+}
+
+static void render_walking()
+{
+    for (uint16_t y = 0; y < gLayout.height(); y++)
+        for (uint16_t x = 0; x < gLayout.width(); x++) gLeds[walk_xy(x, y)] = CRGBW(x, y, 0, 0);
+    gBenchSink = gLeds[0].r;
+}
+
+static double render_ns(const CXYMap & map)
+{
+    return bench_ns([&map] {
+        for (uint16_t y = 0; y < map.height(); y++)
+            for (uint16_t x = 0; x < map.width(); x++) gLeds[map(x, y)] = CRGBW(x, y, 0, 0);
+        gBenchSink = gLeds[0].r;
+    });
+}
+
+int main()
+{
+    std::vector<uint16_t> table16(gLayout.size());
+    std::vector<uint32_t> table32(gLayout.size());
+    compile_xy_layout(gLayout, &table16[0]);
+    compile_xy_layout(gLayout, &table32[0]);
+    for (uint32_t i = 0; i < gLayout.size(); i++) {
+        if (walk_xy(i % gLayout.width(), i / gLayout.width()) != table32[i]) {
+            printf("walk_xy disagrees with compile_xy_layout at %u\n", i);
+            return 1;
+        }
+    }
+
+    uint32_t n = gLayout.size();
+    double walking = bench_report("layout worked out for each led", "pixel", n, bench_ns(render_walking), 0);
+    bench_report("layout from a 16 bit table", "pixel", n, render_ns(CXYMap(gLayout, &table16[0])), walking);
+    bench_report("layout from a 32 bit table", "pixel", n, render_ns(CXYMap(gLayout, &table32[0])), walking);
+    bench_report("plain rows (no layout)", "pixel", n, render_ns(CXYMap(gLayout.width(), gLayout.height())), walking);
+    return 0;
+}
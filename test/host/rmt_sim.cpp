@@ -0,0 +1,671 @@
+// Host simulator for the ESP32 RMT peripheral (see rmt_sim.h)
+
+#include "rmt_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <map>
+#include <vector>
+
+#include "esp_intr.h"
+#include "driver/rmt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+volatile rmt_mem_t RMTMEM;
+volatile gpio_dev_t GPIO;
+
+// -- APB clock cycles (80 MHz) per RMT clock tick are the divider; ESP32
+//    cycles per APB cycle
+#define APB_TO_CPU 3
+
+#define NEVER (~(uint64_t)0)
+
+struct SimChannel {
+    // -- Configuration
+    int      pin;
+    int      clk_div;
+    int      mem_blocks;
+    uint16_t limit;
+
+    // -- Transmission in progress. pos is the pulse being sent, in
+    //    RMTMEM or (builtin driver) in queue; item_end is when it is done.
+    bool     running;
+    int      pos;
+    int      sent;
+    uint32_t item;
+    uint64_t item_end;
+
+    // -- Builtin driver
+    bool            driver;
+    sample_to_rmt_t translator;
+    std::vector<uint32_t> queue;
+};
+
+static SimChannel gChan[RMT_CHANNEL_MAX];
+
+static uint64_t gNow = 0;
+
+static uint32_t gIntRaw = 0;
+static uint32_t gIntEna = 0;
+
+static intr_handler_t gHandler = NULL;
+static void * gHandlerArg = NULL;
+static int gHandlerCore = 0;
+static uint64_t gIntrAt = NEVER;
+static uint32_t gIntrLatency = 0;
+static int gIntrDelayN = -1;
+static uint32_t gIntrDelayExtra = 0;
+static uint32_t gIntrCount = 0;
+static uint32_t gIsrIdfCalls = 0;
+
+static rmt_tx_end_fn_t gTxEnd = NULL;
+static void * gTxEndArg = NULL;
+static uint32_t gMaxTranslated = 0;
+
+static int gCore = 0;
+static bool gInIsr = false;
+static uint32_t gCcountOffset = 0;
+static float gTemperature = 25.0;
+
+struct SimPin {
+    std::vector<RMTSimRun> runs;
+    uint64_t idle_since;
+};
+
+static std::map<int, SimPin> gPins;
+
+// -- Waveform recording
+
+static void record(int pin, uint8_t level, uint64_t cycles)
+{
+    if (cycles == 0) return;
+    std::vector<RMTSimRun> & runs = gPins[pin].runs;
+    if (! runs.empty() && runs.back().level == level) {
+        runs.back().cycles += cycles;
+    } else {
+        RMTSimRun run = { level, cycles };
+        runs.push_back(run);
+    }
+}
+
+static void pin_start(int pin)
+{
+    std::map<int, SimPin>::iterator it = gPins.find(pin);
+    if (it != gPins.end()) record(pin, 0, gNow - it->second.idle_since);
+    else gPins[pin].idle_since = gNow;
+}
+
+static void pin_stop(int pin)
+{
+    gPins[pin].idle_since = gNow;
+}
+
+// -- Interrupts
+
+static void intr_pending()
+{
+    if ((gIntRaw & gIntEna) == 0 || gHandler == NULL || gIntrAt != NEVER) return;
+
+    uint64_t delay = gIntrLatency;
+    if (gIntrDelayN == 0) delay += gIntrDelayExtra;
+    if (gIntrDelayN >= 0) gIntrDelayN--;
+    gIntrAt = gNow + delay;
+}
+
+static void raise(uint32_t bits)
+{
+    gIntRaw |= bits;
+    intr_pending();
+}
+
+static void run_isr()
+{
+    // -- A level interrupt that the handler never clears would keep
+    //    coming back forever
+    static uint64_t last = NEVER;
+    static int repeats = 0;
+    repeats = (last == gNow) ? repeats + 1 : 0;
+    last = gNow;
+    if (repeats > 1000) {
+        fprintf(stderr, "rmt_sim: interrupt storm, status %08x\n", gIntRaw & gIntEna);
+        abort();
+    }
+
+    gIntrAt = NEVER;
+    gIntrCount++;
+    int core = gCore;
+    gCore = gHandlerCore;
+    gInIsr = true;
+    (*gHandler)(gHandlerArg);
+    gInIsr = false;
+    gCore = core;
+    intr_pending();
+}
+
+// -- Channels
+
+static uint64_t tick_cycles(const SimChannel & ch)
+{
+    return (uint64_t) ch.clk_div * APB_TO_CPU;
+}
+
+static void finish(int channel)
+{
+    SimChannel & ch = gChan[channel];
+    ch.running = false;
+    ch.item_end = NEVER;
+    pin_stop(ch.pin);
+
+    if (ch.driver) {
+        if (gTxEnd) {
+            gIntrCount++;
+            gInIsr = true;
+            (*gTxEnd)(rmt_channel_t(channel), gTxEndArg);
+            gInIsr = false;
+        }
+    } else {
+        raise(BIT(channel * 3));
+    }
+}
+
+// -- Start sending the pulse at ch.pos, or stop at a zero pulse
+static void begin_item(int channel)
+{
+    SimChannel & ch = gChan[channel];
+    if (ch.driver) {
+        if (ch.pos >= (int) ch.queue.size()) { finish(channel); return; }
+        ch.item = ch.queue[ch.pos];
+    } else {
+        ch.item = (& RMTMEM.chan[channel].data32[0].val)[ch.pos];
+    }
+
+    rmt_item32_t item;
+    item.val = ch.item;
+    if (item.duration0 == 0) { finish(channel); return; }
+
+    record(ch.pin, item.level0, item.duration0 * tick_cycles(ch));
+    record(ch.pin, item.level1, item.duration1 * tick_cycles(ch));
+    ch.item_end = gNow + (item.duration0 + item.duration1) * tick_cycles(ch);
+}
+
+// -- The pulse being sent is done: move on to the next one, wrapping
+//    around the channel's memory, and raise the threshold interrupt
+//    every limit pulses
+static void end_item(int channel)
+{
+    SimChannel & ch = gChan[channel];
+    rmt_item32_t item;
+    item.val = ch.item;
+
+    ch.pos++;
+    if (! ch.driver) {
+        ch.sent++;
+        if (ch.limit && (ch.sent % ch.limit) == 0) raise(BIT(channel + 24));
+        if (ch.pos == 64 * ch.mem_blocks) ch.pos = 0;
+    }
+
+    if (item.duration1 == 0) { finish(channel); return; }
+    begin_item(channel);
+}
+
+static void start(int channel, bool reset)
+{
+    SimChannel & ch = gChan[channel];
+    if (reset) {
+        ch.pos = 0;
+        ch.sent = 0;
+    }
+    ch.running = true;
+    pin_start(ch.pin);
+    begin_item(channel);
+}
+
+static void stop(int channel)
+{
+    SimChannel & ch = gChan[channel];
+    if (! ch.running) return;
+    ch.running = false;
+    ch.item_end = NEVER;
+    pin_stop(ch.pin);
+}
+
+static void run_task();
+
+// -- Run the next event, if it is no later than limit. Returns false if
+//    there was none. The task, if it can run, runs first.
+static bool step(uint64_t limit)
+{
+    run_task();
+
+    uint64_t next = gIntrAt;
+    int channel = -1;
+    for (int i = 0; i < RMT_CHANNEL_MAX; i++) {
+        if (gChan[i].running && gChan[i].item_end < next) {
+            next = gChan[i].item_end;
+            channel = i;
+        }
+    }
+
+    if (next == NEVER || next > limit) return false;
+
+    gNow = next;
+    if (channel >= 0) end_item(channel);
+    else run_isr();
+    return true;
+}
+
+uint64_t rmt_sim_now() { return gNow; }
+
+void rmt_sim_run(uint64_t cycles)
+{
+    uint64_t until = gNow + cycles;
+    while (step(until)) {}
+    gNow = until;
+}
+
+void rmt_sim_run_until_idle()
+{
+    while (step(NEVER)) {}
+}
+
+void rmt_sim_set_core(int core) { gCore = core; }
+void rmt_sim_set_ccount_offset(uint32_t ccount_offset) { gCcountOffset = ccount_offset; }
+void rmt_sim_set_intr_latency(uint32_t cycles) { gIntrLatency = cycles; }
+
+void rmt_sim_delay_intr(int n, uint32_t extra_cycles)
+{
+    gIntrDelayN = n;
+    gIntrDelayExtra = extra_cycles;
+}
+
+int rmt_sim_intr_core() { return gHandlerCore; }
+uint32_t rmt_sim_intr_count() { return gIntrCount; }
+uint32_t rmt_sim_isr_idf_calls() { return gIsrIdfCalls; }
+uint32_t rmt_sim_max_translated() { return gMaxTranslated; }
+void rmt_sim_set_temperature(float celsius) { gTemperature = celsius; }
+
+const std::vector<RMTSimRun> & rmt_sim_waveform(int pin) { return gPins[pin].runs; }
+
+void rmt_sim_clear_waveforms()
+{
+    for (std::map<int, SimPin>::iterator it = gPins.begin(); it != gPins.end(); ++it) {
+        it->second.runs.clear();
+    }
+}
+
+std::vector<std::vector<uint8_t> > rmt_sim_decode(int pin, uint32_t threshold_ns, uint32_t reset_ns)
+{
+    uint64_t threshold = (uint64_t) threshold_ns * RMT_SIM_CYCLES_PER_US / 1000;
+    uint64_t reset = (uint64_t) reset_ns * RMT_SIM_CYCLES_PER_US / 1000;
+
+    std::vector<std::vector<uint8_t> > frames;
+    std::vector<uint8_t> frame;
+    uint8_t byte = 0;
+    int nbits = 0;
+
+    const std::vector<RMTSimRun> & runs = gPins[pin].runs;
+    for (size_t i = 0; i <= runs.size(); i++) {
+        bool end = (i == runs.size()) || (runs[i].level == 0 && runs[i].cycles >= reset);
+        if (end) {
+            if (nbits) frame.push_back(byte << (8 - nbits));
+            if (! frame.empty()) frames.push_back(frame);
+            frame.clear();
+            byte = 0;
+            nbits = 0;
+        } else if (runs[i].level) {
+            byte = (byte << 1) | (runs[i].cycles >= threshold ? 1 : 0);
+            if (++nbits == 8) {
+                frame.push_back(byte);
+                byte = 0;
+                nbits = 0;
+            }
+        }
+    }
+    return frames;
+}
+
+// -- Register access for the driver (RMT_INTR_STATUS and friends)
+
+extern "C" uint32_t rmt_sim_intr_status(void) { return gIntRaw & gIntEna; }
+extern "C" void rmt_sim_intr_clear(uint32_t bits) { gIntRaw &= ~bits; }
+
+extern "C" void rmt_sim_tx_stop(int channel) { stop(channel); }
+
+extern "C" void rmt_sim_tx_restart(int channel)
+{
+    stop(channel);
+    start(channel, true);
+}
+extern "C" uint32_t rmt_sim_ccount(void) { return (uint32_t) gNow + (gCore ? gCcountOffset : 0); }
+
+// -- IDF RMT driver calls
+
+static void idf_call()
+{
+    if (gInIsr) gIsrIdfCalls++;
+}
+
+extern "C" esp_err_t rmt_config(const rmt_config_t * rmt_param)
+{
+    idf_call();
+    SimChannel & ch = gChan[rmt_param->channel];
+    ch.pin = rmt_param->gpio_num;
+    ch.clk_div = rmt_param->clk_div;
+    ch.mem_blocks = rmt_param->mem_block_num;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_driver_install(rmt_channel_t channel, size_t, int)
+{
+    idf_call();
+    gChan[channel].driver = true;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_set_pin(rmt_channel_t channel, rmt_mode_t, gpio_num_t gpio_num)
+{
+    idf_call();
+    gChan[channel].pin = gpio_num;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_set_tx_intr_en(rmt_channel_t channel, bool en)
+{
+    idf_call();
+    if (en) gIntEna |= BIT(channel * 3);
+    else gIntEna &= ~BIT(channel * 3);
+    intr_pending();
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_set_tx_thr_intr_en(rmt_channel_t channel, bool en, uint16_t evt_thresh)
+{
+    idf_call();
+    gChan[channel].limit = en ? evt_thresh : 0;
+    if (en) gIntEna |= BIT(channel + 24);
+    else gIntEna &= ~BIT(channel + 24);
+    intr_pending();
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_tx_start(rmt_channel_t channel, bool tx_idx_rst)
+{
+    idf_call();
+    gIntRaw &= ~BIT(channel * 3);
+    start(channel, tx_idx_rst);
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_tx_stop(rmt_channel_t channel)
+{
+    idf_call();
+    stop(channel);
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void * arg)
+{
+    idf_call();
+    gTxEnd = function;
+    gTxEndArg = arg;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn)
+{
+    idf_call();
+    gChan[channel].translator = fn;
+    return ESP_OK;
+}
+
+// -- As the IDF driver does: translate enough to fill the channel's
+//    memory to start with, then half of it at a time as it is sent
+extern "C" esp_err_t rmt_write_sample(rmt_channel_t channel, const uint8_t * src, size_t src_size, bool wait_tx_done)
+{
+    idf_call();
+    SimChannel & ch = gChan[channel];
+    if (! ch.driver || ch.translator == NULL) return ESP_FAIL;
+
+    size_t mem_items = 64 * ch.mem_blocks;
+    size_t wanted = mem_items;
+    std::vector<rmt_item32_t> items(mem_items);
+
+    ch.queue.clear();
+    while (src_size > 0) {
+        size_t translated = 0;
+        size_t num = 0;
+        (*ch.translator)(src, &items[0], src_size, wanted, &translated, &num);
+        if (num > gMaxTranslated) gMaxTranslated = num;
+        if (translated == 0) break;
+        for (size_t i = 0; i < num; i++) ch.queue.push_back(items[i].val);
+        src += translated;
+        src_size -= translated;
+        wanted = mem_items / 2;
+    }
+
+    start(channel, true);
+    if (wait_tx_done) {
+        while (ch.running && step(NEVER)) {}
+    }
+    return ESP_OK;
+}
+
+// -- Interrupt allocation
+
+extern "C" int esp_intr_alloc(int, int, intr_handler_t handler, void * arg, intr_handle_t * ret_handle)
+{
+    gHandler = handler;
+    gHandlerArg = arg;
+    gHandlerCore = gCore;
+    if (ret_handle) *ret_handle = (intr_handle_t) &gHandler;
+    intr_pending();
+    return ESP_OK;
+}
+
+extern "C" int esp_intr_free(intr_handle_t)
+{
+    gHandler = NULL;
+    return ESP_OK;
+}
+
+extern "C" void gpio_matrix_out(uint32_t, uint32_t, bool, bool) {}
+
+// -- FreeRTOS
+
+struct SimSemaphore {
+    int count;
+};
+
+extern "C" SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    SimSemaphore * sem = new SimSemaphore;
+    sem->count = 0;
+    return sem;
+}
+
+extern "C" BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    SimSemaphore * s = (SimSemaphore *) sem;
+    if (s->count) return pdFALSE;
+    s->count = 1;
+    return pdTRUE;
+}
+
+extern "C" BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * woken)
+{
+    if (woken) *woken = pdFALSE;
+    return xSemaphoreGive(sem);
+}
+
+// -- The task
+//    A coroutine on a stack of its own, pinned to a core. It runs until
+//    it waits for a semaphore or a notification, and runs again, from
+//    step(), once that has been given. The code outside it and the
+//    interrupt handler never wait for it, so this is one of the orders
+//    the two cores could run in.
+
+struct SimTask {
+    TaskFunction_t code;
+    void *         arg;
+    int            core;
+    ucontext_t     context;
+    std::vector<char> stack;
+    SimSemaphore * waiting_sem;
+    bool           waiting_notify;
+    uint32_t       notify;
+};
+
+static SimTask * gTask = NULL;
+static bool gInTask = false;
+static ucontext_t gMainContext;
+
+static void task_entry()
+{
+    (*gTask->code)(gTask->arg);
+    fprintf(stderr, "rmt_sim: the task returned\n");
+    abort();
+}
+
+static bool task_ready()
+{
+    if (gTask == NULL || gInTask || gInIsr) return false;
+    if (gTask->waiting_sem) return gTask->waiting_sem->count != 0;
+    if (gTask->waiting_notify) return gTask->notify != 0;
+    return true;
+}
+
+static void run_task()
+{
+    while (task_ready()) {
+        int core = gCore;
+        gCore = gTask->core;
+        gInTask = true;
+        swapcontext(&gMainContext, &gTask->context);
+        gInTask = false;
+        gCore = core;
+    }
+}
+
+// -- Called by the task when it has to wait
+static void task_wait()
+{
+    swapcontext(&gTask->context, &gMainContext);
+}
+
+extern "C" BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    SimSemaphore * s = (SimSemaphore *) sem;
+    if (gInTask) {
+        if (ticks != portMAX_DELAY) {
+            fprintf(stderr, "rmt_sim: xSemaphoreTake with a timeout in the task\n");
+            abort();
+        }
+        while (s->count == 0) {
+            gTask->waiting_sem = s;
+            task_wait();
+        }
+        gTask->waiting_sem = NULL;
+        s->count = 0;
+        return pdTRUE;
+    }
+
+    uint64_t until = (ticks == portMAX_DELAY) ? NEVER : gNow + (uint64_t) ticks * 1000 * RMT_SIM_CYCLES_PER_US;
+    while (s->count == 0) {
+        if (gInIsr) {
+            fprintf(stderr, "rmt_sim: xSemaphoreTake in an interrupt handler\n");
+            abort();
+        }
+        if (! step(until)) {
+            if (s->count) break;
+            if (ticks != portMAX_DELAY) return pdFALSE;
+            fprintf(stderr, "rmt_sim: deadlock, waiting for a semaphore that will never be given\n");
+            abort();
+        }
+    }
+    s->count = 0;
+    return pdTRUE;
+}
+
+extern "C" uint32_t xPortGetCoreID(void) { return gCore; }
+extern "C" void vPortYield(void) {}
+
+extern "C" void vTaskDelay(TickType_t ticks)
+{
+    rmt_sim_run((uint64_t) ticks * portTICK_PERIOD_MS * 1000 * RMT_SIM_CYCLES_PER_US);
+}
+
+// -- One task, which starts running straight away. Its stack is sized
+//    for the host, not from the stack size asked for.
+extern "C" BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *, uint32_t, void * arg, UBaseType_t, TaskHandle_t * handle, BaseType_t core)
+{
+    if (gTask != NULL) {
+        fprintf(stderr, "rmt_sim: only one task is supported\n");
+        abort();
+    }
+    gTask = new SimTask;
+    gTask->code = code;
+    gTask->arg = arg;
+    gTask->core = core;
+    gTask->stack.resize(256 * 1024);
+    gTask->waiting_sem = NULL;
+    gTask->waiting_notify = false;
+    gTask->notify = 0;
+    getcontext(&gTask->context);
+    gTask->context.uc_stack.ss_sp = &gTask->stack[0];
+    gTask->context.uc_stack.ss_size = gTask->stack.size();
+    gTask->context.uc_link = NULL;
+    makecontext(&gTask->context, task_entry, 0);
+    if (handle) *handle = gTask;
+    run_task();
+    return pdPASS;
+}
+
+extern "C" uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t)
+{
+    if (! gInTask) {
+        fprintf(stderr, "rmt_sim: ulTaskNotifyTake outside the task\n");
+        abort();
+    }
+    while (gTask->notify == 0) {
+        gTask->waiting_notify = true;
+        task_wait();
+    }
+    gTask->waiting_notify = false;
+    uint32_t value = gTask->notify;
+    gTask->notify = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+extern "C" BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    ((SimTask *) task)->notify++;
+    run_task();
+    return pdPASS;
+}
+
+// -- esp32-hal
+
+extern "C" unsigned long micros()
+{
+    if (! gInIsr) rmt_sim_run(RMT_SIM_CYCLES_PER_US);
+    return gNow / RMT_SIM_CYCLES_PER_US;
+}
+
+extern "C" unsigned long millis()
+{
+    if (! gInIsr) rmt_sim_run(RMT_SIM_CYCLES_PER_US);
+    return gNow / (1000 * RMT_SIM_CYCLES_PER_US);
+}
+
+extern "C" void delay(uint32_t ms) { rmt_sim_run((uint64_t) ms * 1000 * RMT_SIM_CYCLES_PER_US); }
+extern "C" void delayMicroseconds(uint32_t us) { rmt_sim_run((uint64_t) us * RMT_SIM_CYCLES_PER_US); }
+extern "C" void yield(void) {}
+extern "C" float temperatureRead() { return gTemperature; }
+
+// -- Programs that use the 2D functions supply XY(); this one is for the
+//    ones that do not
+__attribute__((weak)) uint16_t XY(uint8_t x, uint8_t y) { return (uint16_t) y * 16 + x; }
@@ -0,0 +1,131 @@
+/*
+ * Host simulator for the ESP32 RMT peripheral
+ *
+ * The host tests build the library and its RMT driver for Linux, against
+ * the stand-in ESP-IDF headers in stubs/. This file is included ahead of
+ * every source file (see the Makefile). It points the driver's direct
+ * register access (FASTLED_RMT_HW_OVERRIDE, see clockless_esp32.h) at the
+ * simulator, which also supplies the rmt_*, xSemaphore*, esp_intr_alloc,
+ * micros() and millis() calls the driver makes.
+ *
+ * Everything runs on one thread, against a simulated clock counted in
+ * ESP32 cycles (240 MHz). Each RMT channel reads its pulses out of RMTMEM
+ * at the configured clock rate, wrapping around its memory blocks. It
+ * raises the threshold interrupt every time it has sent the configured
+ * number of pulses, and the done interrupt when it reaches a zero pulse.
+ * The interrupt handler registered with esp_intr_alloc() runs as soon as
+ * an enabled interrupt is raised, or later if an interrupt latency is set.
+ * It runs on the core that allocated it, and takes no simulated time.
+ * In builtin-driver mode, rmt_write_sample() runs the translator the way
+ * the IDF driver does, half a buffer at a time, and calls the tx end
+ * callback when the last pulse has been sent.
+ *
+ * Simulated time only passes while the program waits: in
+ * xSemaphoreTake(), delay(), and a microsecond for each call to micros()
+ * or millis() outside the interrupt handler (so that busy waits end).
+ * Taking a semaphore that nothing can give any more is a deadlock, and
+ * aborts the test.
+ *
+ * The output of every pin is recorded as a waveform: a list of runs of
+ * high or low output, with idle (low) output between transmissions.
+ * rmt_sim_decode() turns it back into bytes, MSB first, splitting it into
+ * frames at each latch (low output at least as long as the reset time).
+ *
+ * The transmit task (FASTLED_RMT_TX_TASK) runs as a coroutine, on the
+ * core it was pinned to. It starts when it is created, and runs until it
+ * waits for a semaphore or a notification; once that has been given, it
+ * runs again before the next simulated event. Only one task is
+ * supported.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+#include <vector>
+#endif
+
+// -- The driver's direct hardware access goes to the simulator
+#define FASTLED_RMT_HW_OVERRIDE 1
+
+#define RMT_INTR_STATUS()       rmt_sim_intr_status()
+#define RMT_INTR_CLEAR(_BITS)   rmt_sim_intr_clear(_BITS)
+#define RMT_CHANNEL_MEM(_CH)    (& RMTMEM.chan[(_CH)].data32[0].val)
+#define RMT_TX_STOP(_CH)        rmt_sim_tx_stop(_CH)
+#define RMT_TX_RESTART(_CH)     rmt_sim_tx_restart(_CH)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t rmt_sim_intr_status(void);
+void rmt_sim_intr_clear(uint32_t bits);
+void rmt_sim_tx_stop(int channel);
+void rmt_sim_tx_restart(int channel);
+uint32_t rmt_sim_ccount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+static inline uint32_t __clock_cycles() { return rmt_sim_ccount(); }
+
+#ifdef __cplusplus
+
+// -- Simulated time, in ESP32 cycles since startup
+#define RMT_SIM_CYCLES_PER_US 240
+
+uint64_t rmt_sim_now();
+
+// -- Run the simulation for the given time, or until nothing is left to
+//    happen (no channel is sending and no interrupt is pending)
+void rmt_sim_run(uint64_t cycles);
+void rmt_sim_run_until_idle();
+
+// -- The core that the program (outside the interrupt handler) runs on,
+//    and the difference between the cycle counts of the two cores: on
+//    core 1, __clock_cycles() reads ccount_offset more than on core 0.
+void rmt_sim_set_core(int core);
+void rmt_sim_set_ccount_offset(uint32_t ccount_offset);
+
+// -- Delay every interrupt by the given number of cycles, and the nth
+//    interrupt from now (counting from 0) by extra cycles on top of that
+void rmt_sim_set_intr_latency(uint32_t cycles);
+void rmt_sim_delay_intr(int n, uint32_t extra_cycles);
+
+// -- The core the interrupt handler was allocated on, and runs on
+int rmt_sim_intr_core();
+
+// -- Number of times the interrupt handler (ours or the builtin driver's)
+//    has run
+uint32_t rmt_sim_intr_count();
+
+// -- Number of IDF rmt_* calls made from the interrupt handler, which
+//    it must not make when they are not in IRAM
+uint32_t rmt_sim_isr_idf_calls();
+
+// -- Most pulses the translator was asked for in one call, in builtin
+//    driver mode
+uint32_t rmt_sim_max_translated();
+
+// -- Value returned by temperatureRead()
+void rmt_sim_set_temperature(float celsius);
+
+// -- Recorded output of a pin
+struct RMTSimRun {
+    uint8_t  level;
+    uint64_t cycles;
+};
+
+const std::vector<RMTSimRun> & rmt_sim_waveform(int pin);
+void rmt_sim_clear_waveforms();
+
+// -- Decode the output of a pin into frames of bytes. A high pulse at
+//    least threshold_ns long is a one, a shorter one a zero; low output
+//    at least reset_ns long ends a frame. A frame that does not end on a
+//    byte boundary has its last bits in a final, partial byte, shifted
+//    to the top.
+std::vector<std::vector<uint8_t> > rmt_sim_decode(int pin, uint32_t threshold_ns, uint32_t reset_ns);
+
+#endif
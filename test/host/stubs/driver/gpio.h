@@ -0,0 +1,29 @@
+// Host stand-in for driver/gpio.h (see test/host/rmt_sim.h)
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BIT(nr) (1UL << (nr))
+
+typedef enum { GPIO_NUM_0 = 0, GPIO_NUM_MAX = 40 } gpio_num_t;
+
+typedef struct {
+    uint32_t out;
+    uint32_t out_w1ts;
+    uint32_t out_w1tc;
+    union { uint32_t val; } out1, out1_w1ts, out1_w1tc, in1;
+    uint32_t in;
+} gpio_dev_t;
+
+extern volatile gpio_dev_t GPIO;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void gpio_matrix_out(uint32_t gpio, uint32_t signal_idx, bool out_inv, bool oen_inv);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,2 @@
+// Host stand-in for driver/periph_ctrl.h
+#pragma once
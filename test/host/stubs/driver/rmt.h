@@ -0,0 +1,55 @@
+// Host stand-in for driver/rmt.h: the calls are carried out by the RMT
+// simulator (see test/host/rmt_sim.h)
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "soc/rmt_struct.h"
+#include "driver/gpio.h"
+
+typedef enum { RMT_CHANNEL_0 = 0, RMT_CHANNEL_MAX = 8 } rmt_channel_t;
+typedef enum { RMT_MODE_TX = 0, RMT_MODE_RX } rmt_mode_t;
+typedef enum { RMT_CARRIER_LEVEL_LOW = 0, RMT_CARRIER_LEVEL_HIGH } rmt_carrier_level_t;
+typedef enum { RMT_IDLE_LEVEL_LOW = 0, RMT_IDLE_LEVEL_HIGH } rmt_idle_level_t;
+
+typedef struct {
+    bool loop_en;
+    uint32_t carrier_freq_hz;
+    uint8_t carrier_duty_percent;
+    rmt_carrier_level_t carrier_level;
+    bool carrier_en;
+    rmt_idle_level_t idle_level;
+    bool idle_output_en;
+} rmt_tx_config_t;
+
+typedef struct {
+    rmt_mode_t rmt_mode;
+    rmt_channel_t channel;
+    uint8_t clk_div;
+    gpio_num_t gpio_num;
+    uint8_t mem_block_num;
+    rmt_tx_config_t tx_config;
+} rmt_config_t;
+
+typedef void (*rmt_tx_end_fn_t)(rmt_channel_t channel, void * arg);
+typedef void (*sample_to_rmt_t)(const void * src, rmt_item32_t * dest, size_t src_size, size_t wanted_num,
+                                size_t * translated_size, size_t * item_num);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t rmt_config(const rmt_config_t * rmt_param);
+esp_err_t rmt_driver_install(rmt_channel_t channel, size_t rx_buf_size, int intr_alloc_flags);
+esp_err_t rmt_set_pin(rmt_channel_t channel, rmt_mode_t mode, gpio_num_t gpio_num);
+esp_err_t rmt_set_tx_intr_en(rmt_channel_t channel, bool en);
+esp_err_t rmt_set_tx_thr_intr_en(rmt_channel_t channel, bool en, uint16_t evt_thresh);
+esp_err_t rmt_tx_start(rmt_channel_t channel, bool tx_idx_rst);
+esp_err_t rmt_tx_stop(rmt_channel_t channel);
+esp_err_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void * arg);
+esp_err_t rmt_translator_init(rmt_channel_t channel, sample_to_rmt_t fn);
+esp_err_t rmt_write_sample(rmt_channel_t channel, const uint8_t * src, size_t src_size, bool wait_tx_done);
+
+#ifdef __cplusplus
+}
+#endif
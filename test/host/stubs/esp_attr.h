@@ -0,0 +1,5 @@
+// Host stand-in for esp_attr.h: there is no IRAM or DRAM on the host
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
@@ -0,0 +1,7 @@
+// Host stand-in for esp_err.h
+#pragma once
+
+typedef int esp_err_t;
+
+#define ESP_OK    0
+#define ESP_FAIL -1
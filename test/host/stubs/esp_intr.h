@@ -0,0 +1,20 @@
+// Host stand-in for esp_intr.h (see test/host/rmt_sim.h)
+#pragma once
+
+typedef void * intr_handle_t;
+typedef void (*intr_handler_t)(void * arg);
+
+#define ETS_RMT_INTR_SOURCE   47
+#define ESP_INTR_FLAG_LEVEL3  (1 << 3)
+#define ESP_INTR_FLAG_IRAM    (1 << 10)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int esp_intr_alloc(int source, int flags, intr_handler_t handler, void * arg, intr_handle_t * ret_handle);
+int esp_intr_free(intr_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,9 @@
+// Host stand-in for esp_log.h: errors and warnings go to stderr
+#pragma once
+
+#include <stdio.h>
+
+#define ESP_LOGE(_TAG, _FMT, ...) fprintf(stderr, "E (%s) " _FMT "\n", _TAG, ##__VA_ARGS__)
+#define ESP_LOGW(_TAG, _FMT, ...) fprintf(stderr, "W (%s) " _FMT "\n", _TAG, ##__VA_ARGS__)
+#define ESP_LOGI(_TAG, _FMT, ...)
+#define ESP_LOGD(_TAG, _FMT, ...)
@@ -0,0 +1,35 @@
+// Host stand-in for freertos/FreeRTOS.h (see test/host/rmt_sim.h)
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+
+typedef int portBASE_TYPE;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  0
+#define pdPASS  1
+
+#define portMAX_DELAY       0xFFFFFFFF
+#define portTICK_PERIOD_MS  (1000 / CONFIG_FREERTOS_HZ)
+#define portNUM_PROCESSORS  2
+#define portYIELD_FROM_ISR()
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY      0x7FFFFFFF
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t xPortGetCoreID(void);
+void vPortYield(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+// Host stand-in for freertos/semphr.h. Taking a semaphore that is not
+// available runs the simulated hardware until it is (see
+// test/host/rmt_sim.h).
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void * SemaphoreHandle_t;
+typedef SemaphoreHandle_t xSemaphoreHandle;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * woken);
+
+#ifdef __cplusplus
+}
+#endif
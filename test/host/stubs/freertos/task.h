@@ -0,0 +1,22 @@
+// Host stand-in for freertos/task.h. The simulator runs everything on one
+// thread, with the one task as a coroutine (see test/host/rmt_sim.h).
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void * TaskHandle_t;
+typedef void (*TaskFunction_t)(void * arg);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char * name, uint32_t stack, void * arg,
+                                   UBaseType_t priority, TaskHandle_t * handle, BaseType_t core);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+#ifdef __cplusplus
+}
+#endif
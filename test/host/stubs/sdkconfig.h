@@ -0,0 +1,5 @@
+// Host stand-in for the ESP-IDF sdkconfig.h (see test/host/rmt_sim.h)
+#pragma once
+
+#define CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ 240
+#define CONFIG_FREERTOS_HZ 1000
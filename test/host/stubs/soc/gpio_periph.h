@@ -0,0 +1,4 @@
+// Host stand-in for soc/gpio_periph.h
+#pragma once
+
+#include "driver/gpio.h"
@@ -0,0 +1,12 @@
+// Host stand-in for soc/gpio_reg.h
+#pragma once
+
+#include <stdint.h>
+
+// -- Pointer sized, so that esp32-hal.h can cast them to pointers
+#define GPIO_OUT_REG      ((uintptr_t)0)
+#define GPIO_OUT1_REG     ((uintptr_t)0)
+#define GPIO_IN_REG       ((uintptr_t)0)
+#define GPIO_IN1_REG      ((uintptr_t)0)
+#define GPIO_ENABLE_REG   ((uintptr_t)0)
+#define GPIO_ENABLE1_REG  ((uintptr_t)0)
@@ -0,0 +1,28 @@
+// Host stand-in for soc/rmt_struct.h. The simulator reads the pulses
+// out of RMTMEM; the registers are modelled by the simulator itself (see
+// test/host/rmt_sim.h).
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    union {
+        struct {
+            uint32_t duration0 :15;
+            uint32_t level0 :1;
+            uint32_t duration1 :15;
+            uint32_t level1 :1;
+        };
+        uint32_t val;
+    };
+} rmt_item32_t;
+
+typedef struct {
+    struct {
+        union {
+            rmt_item32_t data32[64];
+        };
+    } chan[8];
+} rmt_mem_t;
+
+extern volatile rmt_mem_t RMTMEM;
@@ -0,0 +1,28 @@
+// Checks for the host tests. Each test is a program of its own: it runs
+// its checks and returns test_result() from main().
+#pragma once
+
+#include <stdio.h>
+
+static int gChecks = 0;
+static int gFailures = 0;
+
+#define CHECK(_COND) do { \
+        gChecks++; \
+        if (! (_COND)) { \
+            gFailures++; \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_COND); \
+        } \
+    } while (0)
+
+static inline int test_result(const char * name)
+{
+    printf("%s: %d checks, %d failed\n", name, gChecks, gFailures);
+    return gFailures ? 1 : 0;
+}
+
+// -- Decoding clockless output (see rmt_sim_decode): a high pulse of at
+//    least 450 ns is a one for every chipset the tests use (SK6812 sends
+//    300 or 600 ns, WS2812 250 or 875 ns), and 50 us low latches the strip
+#define ONE_NS   450
+#define LATCH_NS 50000
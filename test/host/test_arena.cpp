@@ -0,0 +1,71 @@
+// The staging buffers follow the controllers: a controller added after
+// the first frame, and a strip that grows, are sent in full
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[40];
+static CRGBW leds2[30];
+
+// -- GRB order, so that the frames go through the staging buffers
+static std::vector<uint8_t> expected(const CRGBW * leds, int n)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        bytes.push_back(leds[i].g);
+        bytes.push_back(leds[i].r);
+        bytes.push_back(leds[i].b);
+        bytes.push_back(leds[i].w);
+    }
+    return bytes;
+}
+
+static void check_frame(int pin, const std::vector<uint8_t> & bytes)
+{
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(pin, ONE_NS, LATCH_NS);
+    CHECK(frames.size() == 1);
+    CHECK(! frames.empty() && frames.back() == bytes);
+}
+
+static void show()
+{
+    rmt_sim_clear_waveforms();
+    FastLED.show();
+    rmt_sim_run_until_idle();
+}
+
+int main()
+{
+    for (int i = 0; i < 40; i++) leds1[i] = CRGBW(i, i + 1, i + 2, i + 3);
+    for (int i = 0; i < 30; i++) leds2[i] = CRGBW(100 + i, 50, i, 7);
+
+    CLEDController & strip1 = FastLED.addLeds<SK6812W, 5, GRB>(leds1, 20);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    show();
+    check_frame(5, expected(leds1, 20));
+
+    // -- A controller added after the arena was allocated
+    FastLED.addLeds<SK6812W, 18, GRB>(leds2, 30)
+        .setCorrection(CRGBW(255, 255, 255, 255))
+        .setTemperature(CRGBW(255, 255, 255, 255))
+        .setDither(DISABLE_DITHER);
+    show();
+    check_frame(5, expected(leds1, 20));
+    check_frame(18, expected(leds2, 30));
+
+    // -- A strip that grows
+    strip1.setLeds(leds1, 40);
+    show();
+    check_frame(5, expected(leds1, 40));
+    check_frame(18, expected(leds2, 30));
+
+    // -- And shrinks again, in the same arena
+    strip1.setLeds(leds1, 10);
+    show();
+    check_frame(5, expected(leds1, 10));
+    check_frame(18, expected(leds2, 30));
+
+    return test_result("arena");
+}
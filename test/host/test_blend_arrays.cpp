@@ -0,0 +1,67 @@
+// nblend and blend on CRGBW arrays, a pixel at a time, give the same result
+// as blend8 on every channel, for every amount, with the output in place
+// or separate, on arrays that are and are not word aligned
+
+#include "FastLED.h"
+#include "test.h"
+
+#define NUM 21
+
+static uint8_t gSource1[4 * NUM];
+static uint8_t gSource2[4 * NUM];
+static uint8_t gBuffer1[4 * NUM + 4];
+static uint8_t gBuffer2[4 * NUM + 4];
+static uint8_t gBuffer3[4 * NUM + 4];
+
+static bool matches(const CRGBW * out, int amount)
+{
+    const uint8_t * p = (const uint8_t *)out;
+    for (int i = 0; i < 4 * NUM; i++) {
+        if (p[i] != blend8(gSource1[i], gSource2[i], amount)) return false;
+    }
+    return true;
+}
+
+static bool same_as_blend8(int offset1, int offset2, int offset3)
+{
+    CRGBW * a = (CRGBW *)(gBuffer1 + offset1);
+    CRGBW * b = (CRGBW *)(gBuffer2 + offset2);
+    CRGBW * out = (CRGBW *)(gBuffer3 + offset3);
+
+    for (int amount = 0; amount < 256; amount++) {
+        // -- Into a third array
+        memcpy((void *)a, gSource1, sizeof(gSource1));
+        memcpy((void *)b, gSource2, sizeof(gSource2));
+        blend(a, b, out, NUM, amount);
+        if (! matches(out, amount)) return false;
+
+        // -- In place, over either source
+        nblend(a, b, NUM, amount);
+        if (! matches(a, amount)) return false;
+
+        memcpy((void *)a, gSource1, sizeof(gSource1));
+        blend(a, b, b, NUM, amount);
+        if (! matches(b, amount)) return false;
+    }
+    return true;
+}
+
+int main()
+{
+    random16_set_seed(11);
+    for (int i = 0; i < 4 * NUM; i++) {
+        gSource1[i] = random8();
+        gSource2[i] = random8();
+    }
+    gSource1[0] = 0;   gSource2[0] = 255;
+    gSource1[1] = 255; gSource2[1] = 0;
+    gSource1[2] = 255; gSource2[2] = 255;
+    gSource1[3] = 0;   gSource2[3] = 0;
+
+    CHECK(same_as_blend8(0, 0, 0));
+    CHECK(same_as_blend8(1, 0, 0));
+    CHECK(same_as_blend8(0, 2, 0));
+    CHECK(same_as_blend8(0, 0, 3));
+
+    return test_result("blend_arrays");
+}
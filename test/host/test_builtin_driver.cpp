@@ -0,0 +1,74 @@
+// The builtin-driver mode sends the same bytes as our own driver, with
+// the IDF driver converting them to pulses a piece at a time through our
+// translator; only the bytes are buffered
+
+#define FASTLED_RMT_BUILTIN_DRIVER 1
+#define FASTLED_RMT_MAX_CHANNELS 2
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[300];
+static CRGBW leds2[37];
+static CRGBW leds3[64];
+
+static std::vector<uint8_t> expected(const CRGBW * leds, int n, const int * order, int nBytes, uint8_t scale)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < nBytes; j++) bytes.push_back(scale8(leds[i].raw[order[j]], scale));
+    }
+    return bytes;
+}
+
+static const int RGBW_ORDER[] = { 0, 1, 2, 3 };
+static const int GRB_ORDER[] = { 1, 0, 2 };
+
+static void check_frame(int pin, const std::vector<uint8_t> & bytes)
+{
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(pin, ONE_NS, LATCH_NS);
+    CHECK(frames.size() == 1);
+    CHECK(! frames.empty() && frames.back() == bytes);
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds1, 300);
+    FastLED.addLeds<WS2812, 18, GRB>(leds2, 37);
+    FastLED.addLeds<SK6812W, 19, RGB>(leds3, 64);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+
+    random16_set_seed(4321);
+    for (int i = 0; i < 300; i++) leds1[i] = CRGBW(random8(), random8(), random8(), random8());
+    for (int i = 0; i < 37; i++) leds2[i] = CRGBW(random8(), random8(), random8(), 0);
+    for (int i = 0; i < 64; i++) leds3[i] = CRGBW(i, 255 - i, i * 3, i * 7);
+
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    check_frame(5, expected(leds1, 300, RGBW_ORDER, 4, 255));
+    check_frame(18, expected(leds2, 37, GRB_ORDER, 3, 255));
+    check_frame(19, expected(leds3, 64, RGBW_ORDER, 4, 255));
+
+    rmt_sim_clear_waveforms();
+    FastLED.setBrightness(100);
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    check_frame(5, expected(leds1, 300, RGBW_ORDER, 4, 100));
+    check_frame(18, expected(leds2, 37, GRB_ORDER, 3, 100));
+    check_frame(19, expected(leds3, 64, RGBW_ORDER, 4, 100));
+
+    // -- The translator is never asked for more pulses than the channel's
+    //    memory holds, and the only buffers are the bytes themselves
+    //    (the 37 led strip's 111 bytes rounded up to a word), where a
+    //    pulse for every bit used to take 32 bytes per byte
+    int data_bytes = 300 * 4 + 37 * 3 + 64 * 4;
+    CHECK(rmt_sim_max_translated() > 0);
+    CHECK(rmt_sim_max_translated() <= 64 * FASTLED_RMT_MEM_BLOCKS);
+    CHECK(gArenaSize == data_bytes + 1);
+    printf("builtin_driver: %d bytes of pixel data, %d bytes of buffers (%d as pulses), at most %u pulses translated at once\n",
+           data_bytes, gArenaSize, data_bytes * 32, rmt_sim_max_translated());
+
+    return test_result("builtin_driver");
+}
@@ -0,0 +1,48 @@
+// The dithering bits a controller picks from the time between its frames
+// give a full dithering cycle of 2^bits frames at no less than
+// MIN_ACCEPTABLE_DITHER_RATE_HZ (50 Hz, 20 ms)
+
+#include "FastLED.h"
+#include "test.h"
+
+class NullController : public CPixelLEDController<RGB> {
+public:
+    virtual void init() {}
+    virtual void showPixels(PixelController<RGB> &) {}
+};
+
+static NullController controller;
+
+// -- The bits picked for frames shown every period_us (each call to
+//    micros() takes the simulated clock on by a microsecond)
+static uint8_t bits_at(uint32_t period_us)
+{
+    uint8_t frame;
+    uint8_t bits = 0;
+    for (int i = 0; i < 4; i++) {
+        rmt_sim_run((uint64_t)(period_us - 1) * RMT_SIM_CYCLES_PER_US);
+        bits = controller.stepDither(frame);
+    }
+    return bits;
+}
+
+int main()
+{
+    // -- 40 and 60 FPS: even a two frame cycle (50 or 33 ms) is too slow
+    CHECK(bits_at(25000) == 0);
+    CHECK(bits_at(16667) == 0);
+    // -- 120 FPS: two frames, 17 ms
+    CHECK(bits_at(8333) == 1);
+    // -- 400 FPS: four frames, 10 ms
+    CHECK(bits_at(2500) == 2);
+    // -- 1000 FPS: sixteen frames, 16 ms
+    CHECK(bits_at(1000) == 4);
+
+    // -- The frame counter moves on once a frame
+    uint8_t before, after;
+    controller.stepDither(before);
+    controller.stepDither(after);
+    CHECK((uint8_t)(after - before) == 1);
+
+    return test_result("dither_bits");
+}
@@ -0,0 +1,67 @@
+// With double buffering, the next frame is staged in the second buffer
+// while the first is still on the wire: each frame goes out as it was
+// when it was shown, whatever happens to the leds afterwards
+
+#define FASTLED_RMT_DOUBLE_BUFFER 1
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[50];
+static CRGBW leds2[20];
+
+// -- The bytes a strip should get at brightness 200 (which keeps the
+//    frame from being sent straight from the leds)
+static std::vector<uint8_t> expected(const CRGBW * leds, int n)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 4; j++) bytes.push_back(scale8(leds[i].raw[j], 200));
+    }
+    return bytes;
+}
+
+static void fill_frame(int frame)
+{
+    for (int i = 0; i < 50; i++) leds1[i] = CRGBW(frame, i, 3 * i + frame, 255 - i);
+    for (int i = 0; i < 20; i++) leds2[i] = CRGBW(i, frame, 7 * frame, i + frame);
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds1, 50);
+    FastLED.addLeds<SK6812W, 18, RGB>(leds2, 20);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    FastLED.setBrightness(200);
+    // -- Or show() waits out the rest of the frame before it starts
+    FastLED.setMaxRefreshRate(0);
+
+    // -- Frames 1 to 3 shown back to back, each staged while the one
+    //    before is being sent, and the leds changed as soon as each
+    //    show returns
+    std::vector<std::vector<uint8_t> > sent1, sent2;
+    for (int frame = 1; frame <= 3; frame++) {
+        fill_frame(frame);
+        sent1.push_back(expected(leds1, 50));
+        sent2.push_back(expected(leds2, 20));
+        FastLED.showAsync();
+        CHECK(FastLED.isShowing());
+        fill_frame(100 + frame);
+    }
+    FastLED.waitForShow();
+    rmt_sim_run_until_idle();
+    CHECK(rmt_sim_decode(5, ONE_NS, LATCH_NS) == sent1);
+    CHECK(rmt_sim_decode(18, ONE_NS, LATCH_NS) == sent2);
+
+    // -- A synchronous show after them uses the other buffer again
+    rmt_sim_clear_waveforms();
+    fill_frame(4);
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    CHECK(rmt_sim_decode(5, ONE_NS, LATCH_NS) == std::vector<std::vector<uint8_t> >(1, expected(leds1, 50)));
+    CHECK(rmt_sim_decode(18, ONE_NS, LATCH_NS) == std::vector<std::vector<uint8_t> >(1, expected(leds2, 20)));
+
+    return test_result("double_buffer");
+}
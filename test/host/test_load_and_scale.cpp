@@ -0,0 +1,107 @@
+// PixelController::loadAndScalePixels gives the same bytes, and leaves the
+// same state behind, as loadAndScale0..3, advanceData and stepDithering
+// one pixel at a time
+
+#include "FastLED.h"
+#include "test.h"
+
+static uint8_t gData[4 * 33 + 8];
+
+template<EOrder RGB_ORDER, int BYTES> static bool same_as_bytewise(int offset, int advance, int n, CRGBW scale, int ditherBits, uint8_t R)
+{
+    const uint8_t * data = gData + offset;
+    PixelController<RGB_ORDER> a(data, n, scale, DISABLE_DITHER, advance != 0);
+    PixelController<RGB_ORDER> b(data, n, scale, DISABLE_DITHER, advance != 0);
+    if (ditherBits) {
+        a.init_binary_dithering(R, ditherBits);
+        b.init_binary_dithering(R, ditherBits);
+    }
+
+    uint8_t batched[4 * 33];
+    a.template loadAndScalePixels<BYTES>(batched, n);
+
+    uint8_t bytewise[4 * 33];
+    uint8_t * p = bytewise;
+    for (int i = 0; i < n; i++) {
+        p[0] = b.loadAndScale0();
+        p[1] = b.loadAndScale1();
+        p[2] = b.loadAndScale2();
+        if (BYTES == 4) p[3] = b.loadAndScale3();
+        p += BYTES;
+        b.advanceData();
+        b.stepDithering();
+    }
+
+    if (memcmp(batched, bytewise, n * BYTES) != 0) return false;
+    if (a.mData != b.mData || a.mLenRemaining != b.mLenRemaining) return false;
+    for (int i = 0; i < 4; i++) {
+        if (a.d[i] != b.d[i] || a.e[i] != b.e[i]) return false;
+    }
+    return true;
+}
+
+template<EOrder RGB_ORDER> static bool check_order()
+{
+    static const uint8_t scales[][4] = {
+        { 255, 255, 255, 255 }, { 0, 0, 0, 0 }, { 1, 2, 3, 4 }, { 128, 64, 200, 255 }, { 255, 0, 17, 254 }
+    };
+
+    bool same = true;
+    for (int s = 0; s < 5; s++) {
+        CRGBW scale(scales[s][0], scales[s][1], scales[s][2], scales[s][3]);
+        for (int bits = 0; bits <= 3; bits++) {
+            for (int R = 0; R < (1 << bits); R++) {
+                for (int offset = 0; offset < 4; offset++) {
+                    for (int n = 0; n <= 33; n += 11) {
+                        same = same && same_as_bytewise<RGB_ORDER, 3>(offset, 1, n, scale, bits, R);
+                        same = same && same_as_bytewise<RGB_ORDER, 4>(offset, 1, n, scale, bits, R);
+                        same = same && same_as_bytewise<RGB_ORDER, 4>(offset, 0, n, scale, bits, R);
+                    }
+                }
+            }
+        }
+    }
+    return same;
+}
+
+// -- The CRGBW channels one pixel goes out as, a byte at a time and packed
+template<EOrder RGB_ORDER> static bool wire_order(int c0, int c1, int c2, int c3)
+{
+    static const uint8_t pixel[4] = { 0x11, 0x22, 0x33, 0x44 };
+    const uint8_t want[4] = { pixel[c0], pixel[c1], pixel[c2], pixel[c3] };
+    CRGBW scale(255, 255, 255, 255);
+
+    PixelController<RGB_ORDER> a(pixel, 1, scale, DISABLE_DITHER);
+    uint8_t bytewise[4] = { a.loadAndScale0(), a.loadAndScale1(), a.loadAndScale2(), a.loadAndScale3() };
+
+    PixelController<RGB_ORDER> b(pixel, 1, scale, DISABLE_DITHER);
+    uint8_t packed[4];
+    b.template loadAndScalePixels<4>(packed, 1);
+
+    return memcmp(bytewise, want, 4) == 0 && memcmp(packed, want, 4) == 0;
+}
+
+int main()
+{
+    random16_set_seed(99);
+    for (size_t i = 0; i < sizeof(gData); i++) gData[i] = random8();
+    // -- Values the dithering must not touch, or that saturate
+    gData[0] = 0; gData[5] = 255; gData[10] = 1; gData[15] = 254;
+
+    CHECK(check_order<RGB>());
+    CHECK(check_order<GRB>());
+    CHECK(check_order<BRG>());
+    CHECK(check_order<BGR>());
+    CHECK(check_order<WRGB>());
+    CHECK(check_order<WGRB>());
+    CHECK(check_order<WBGR>());
+
+    // -- The W-first orders send white first, then the colors in order,
+    //    both ways
+    CHECK(wire_order<WRGB>(3, 0, 1, 2));
+    CHECK(wire_order<WGRB>(3, 1, 0, 2));
+    CHECK(wire_order<WBGR>(3, 2, 1, 0));
+    CHECK(wire_order<GRB>(1, 0, 2, 3));
+
+    return test_result("load_and_scale");
+}
@@ -0,0 +1,71 @@
+// With several memory blocks to a channel, the driver refills a half of
+// all of them at a time, and what comes out still decodes back to the
+// bytes for each strip: a strip shorter than half the buffer, one that
+// does not end on a refill, and one that goes out after another on the
+// same channel. test_mem_blocks4.cpp runs the same checks with 4 blocks.
+
+#ifndef FASTLED_RMT_MEM_BLOCKS
+#define FASTLED_RMT_MEM_BLOCKS 2
+#endif
+#define FASTLED_RMT_MAX_CHANNELS 2
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[101];
+static CRGBW leds2[37];
+static CRGBW leds3[1];
+
+static std::vector<uint8_t> expected(const CRGBW * leds, int n, const int * order, int nBytes)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < nBytes; j++) bytes.push_back(leds[i].raw[order[j]]);
+    }
+    return bytes;
+}
+
+static const int RGBW_ORDER[] = { 0, 1, 2, 3 };
+static const int GRB_ORDER[] = { 1, 0, 2 };
+
+static void check_frame(int pin, const std::vector<uint8_t> & bytes)
+{
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(pin, ONE_NS, LATCH_NS);
+    CHECK(frames.size() == 1);
+    CHECK(! frames.empty() && frames.back() == bytes);
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds1, 101);
+    FastLED.addLeds<WS2812, 18, GRB>(leds2, 37);
+    FastLED.addLeds<SK6812W, 19, RGB>(leds3, 1);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+
+    random16_set_seed(2);
+    for (int i = 0; i < 101; i++) leds1[i] = CRGBW(random8(), random8(), random8(), random8());
+    for (int i = 0; i < 37; i++) leds2[i] = CRGBW(random8(), random8(), random8(), 0);
+    leds3[0] = CRGBW(0x81, 0x42, 0x24, 0x18);
+
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    check_frame(5, expected(leds1, 101, RGBW_ORDER, 4));
+    check_frame(18, expected(leds2, 37, GRB_ORDER, 3));
+    check_frame(19, expected(leds3, 1, RGBW_ORDER, 4));
+
+    // -- The long strip alone: an interrupt for each half buffer of
+    //    32 * FASTLED_RMT_MEM_BLOCKS pulses sent, and one when it is done
+    FastLED[1].setLeds(leds2, 0);
+    FastLED[2].setLeds(leds3, 0);
+    rmt_sim_clear_waveforms();
+    uint32_t before = rmt_sim_intr_count();
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    check_frame(5, expected(leds1, 101, RGBW_ORDER, 4));
+    uint32_t halves = (101 * 32 + 32 * FASTLED_RMT_MEM_BLOCKS - 1) / (32 * FASTLED_RMT_MEM_BLOCKS);
+    CHECK(rmt_sim_intr_count() - before <= halves + 1);
+
+    return test_result(FASTLED_RMT_MEM_BLOCKS == 4 ? "mem_blocks4" : "mem_blocks2");
+}
@@ -0,0 +1,5 @@
+// test_mem_blocks.cpp with 4 memory blocks to a channel
+
+#define FASTLED_RMT_MEM_BLOCKS 4
+
+#include "test_mem_blocks.cpp"
@@ -0,0 +1,134 @@
+// Frames recorded from an animation (time since the last frame, and the
+// level of every led) replayed through the governor give the brightness of
+// a plain model of it, frame by frame: the draw averaged with
+// exponential weights over the window, and the brightness moved towards
+// the limit no faster than the attack and release times. A flash shorter
+// than the window is dimmed less than a frame at a time would dim it, held
+// bright content is dimmed as the average catches up, and a gap longer
+// than the window starts the average over
+
+#include <math.h>
+#include "FastLED.h"
+#include "test.h"
+
+#define NUM        100
+#define MAX_MW     4000
+#define MCU_MW     125
+#define WINDOW_MS  200
+#define ATTACK_MS  100
+#define RELEASE_MS 500
+
+class NullController : public CPixelLEDController<RGB> {
+public:
+    virtual void init() {}
+    virtual void showPixels(PixelController<RGB> &) {}
+};
+
+static CRGBW leds[NUM];
+static NullController controller;
+
+struct Frame {
+    uint16_t dt_ms;
+    uint8_t  level;
+};
+
+// -- Dim at 60 fps, a 3 frame flash, a frame dropped, a long bright scene,
+//    a 300 ms stall, and back to dim
+static const Frame gFrames[] = {
+    { 0, 20 }, { 17, 20 }, { 16, 24 }, { 17, 30 }, { 17, 30 }, { 16, 32 },
+    { 17, 255 }, { 17, 255 }, { 16, 255 },
+    { 17, 40 }, { 33, 40 }, { 17, 45 }, { 16, 50 },
+    { 17, 200 }, { 17, 210 }, { 16, 220 }, { 17, 230 }, { 17, 240 }, { 16, 250 },
+    { 17, 255 }, { 17, 255 }, { 16, 255 }, { 17, 255 }, { 17, 255 }, { 16, 255 },
+    { 17, 255 }, { 17, 255 }, { 16, 255 }, { 17, 255 }, { 17, 255 }, { 16, 255 },
+    { 300, 255 }, { 17, 255 },
+    { 17, 10 }, { 16, 10 }, { 17, 10 }, { 17, 10 }, { 16, 10 }, { 17, 10 },
+    { 17, 10 }, { 16, 10 }, { 17, 10 }, { 17, 10 }, { 16, 10 }, { 17, 10 },
+};
+#define FRAMES (int)(sizeof(gFrames) / sizeof(gFrames[0]))
+
+// -- The governor as the documentation in power_mgt.h describes it
+static double gAverage;
+static double gLevel;
+
+static uint8_t model_frame(bool first, uint32_t unscaled_mW, uint32_t dt)
+{
+    if (first || dt >= WINDOW_MS) {
+        gAverage = unscaled_mW;
+    } else {
+        gAverage += (unscaled_mW - gAverage) * dt / WINDOW_MS;
+    }
+
+    double requested_mW = (MCU_MW + gAverage) * 255 / 256;
+    double want = (requested_mW < MAX_MW) ? 255 : floor(255 * MAX_MW / requested_mW);
+
+    if (first) {
+        gLevel = want;
+    } else if (want < gLevel) {
+        gLevel = fmax(want, gLevel - 255.0 * dt / ATTACK_MS);
+    } else {
+        gLevel = fmin(want, gLevel + 255.0 * dt / RELEASE_MS);
+    }
+    return (uint8_t)gLevel;
+}
+
+// -- The brightness, up to 255, that keeps a single frame under the limit
+static uint8_t frame_brightness(uint32_t unscaled_mW)
+{
+    uint32_t requested_mW = (MCU_MW + unscaled_mW) * 255 / 256;
+    return (requested_mW < MAX_MW) ? 255 : 255 * MAX_MW / requested_mW;
+}
+
+int main()
+{
+    FastLED.addLeds(&controller, leds, NUM);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    set_power_governor(WINDOW_MS, ATTACK_MS, RELEASE_MS, 0);
+
+    uint8_t brightness[FRAMES];
+    uint8_t model[FRAMES];
+    uint8_t unaveraged[FRAMES];
+    int differ = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        rmt_sim_run((uint64_t)gFrames[f].dt_ms * 1000 * RMT_SIM_CYCLES_PER_US);
+        uint8_t v = gFrames[f].level;
+        fill_solid(leds, NUM, CRGBW(v, v, v, v));
+        uint32_t mW = calculate_unscaled_power_mW(leds, NUM);
+
+        brightness[f] = calculate_max_brightness_for_power_mW(255, MAX_MW);
+        model[f] = model_frame(f == 0, mW, gFrames[f].dt_ms);
+        unaveraged[f] = frame_brightness(mW);
+        // -- The governor works in whole milliwatts and 8.8 fixed point
+        if (abs(brightness[f] - model[f]) > 1) differ++;
+    }
+    CHECK(differ == 0);
+
+    // -- The flash (frames 6 to 8) is dimmed, but much less than on its own
+    CHECK(unaveraged[6] < 128);
+    CHECK(brightness[8] < 255);
+    CHECK(brightness[8] > unaveraged[8] + 64);
+
+    // -- Held bright, the brightness falls towards the frame limit as the
+    //    average catches up, but no lower
+    bool falling = true;
+    for (int f = 20; f <= 30; f++) {
+        if (brightness[f] > brightness[f - 1] || brightness[f] < unaveraged[f]) falling = false;
+    }
+    CHECK(falling);
+    CHECK(brightness[30] < brightness[19] - 10);
+
+    // -- After the stall the average starts over from the frame's draw
+    CHECK(brightness[31] == unaveraged[31]);
+
+    // -- Back to dim, the brightness comes back no faster than the release
+    //    time allows: 255 in 500 ms, under 9 a frame
+    bool rising = true;
+    for (int f = 33; f < FRAMES; f++) {
+        if (brightness[f] <= brightness[f - 1] || brightness[f] - brightness[f - 1] > 9) rising = false;
+    }
+    CHECK(rising);
+    CHECK(brightness[FRAMES - 1] < 255);
+
+    return test_result("power_governor");
+}
@@ -0,0 +1,94 @@
+// With power tracking on, the running sums kept block by block match a
+// full count after reported changes, within a block, across blocks and in
+// the short last block; a reversed CPixelView reports exactly its own leds;
+// turning tracking back on counts again the changes made while it was off;
+// and changes nobody reported are counted as mismatches (this test links a
+// power_mgt.cpp built with FASTLED_POWER_TRACK_VALIDATE, see the Makefile)
+
+#include "FastLED.h"
+#include "test.h"
+
+// -- 3 blocks of 32 leds and one of 4
+#define NUM    100
+#define MAX_MW 500
+
+class NullController : public CPixelLEDController<RGB> {
+public:
+    virtual void init() {}
+    virtual void showPixels(PixelController<RGB> &) {}
+};
+
+static CRGBW leds[NUM];
+static NullController controller;
+
+// -- The brightness, up to 255, that keeps leds drawing unscaled_mW at
+//    full brightness under max_mW (as power_mgt.cpp works it out)
+static uint8_t brightness_for(uint32_t unscaled_mW, uint32_t max_mW)
+{
+    uint32_t requested_mW = unscaled_mW * 255 / 256;
+    return (requested_mW < max_mW) ? 255 : 255 * max_mW / requested_mW;
+}
+
+// -- Run the power limit once: true if the running sums needed no
+//    correction, and the brightness is the one a full count gives
+static bool sums_up_to_date()
+{
+    uint32_t mismatches = power_track_mismatches();
+    uint8_t b = calculate_max_brightness_for_power_mW(255, MAX_MW);
+    return power_track_mismatches() == mismatches && b == brightness_for(calculate_unscaled_power_mW(leds, NUM), MAX_MW);
+}
+
+int main()
+{
+    random16_set_seed(19);
+    for (int i = 0; i < NUM; i++) leds[i] = CRGBW(random8(), random8(), random8(), random8());
+    FastLED.addLeds(&controller, leds, NUM);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    set_power_tracking(true);
+    CHECK(sums_up_to_date());
+    CHECK(calculate_max_brightness_for_power_mW(255, MAX_MW) < 255);
+
+    // -- One led, leds across a block boundary, the short last block
+    leds[40] = CRGBW(1, 2, 3, 4);
+    power_track_changed(&leds[40], 1);
+    CHECK(sums_up_to_date());
+    for (int i = 28; i < 36; i++) leds[i] = CRGBW(i, 0, 2 * i, 0);
+    power_track_changed(&leds[28], 8);
+    CHECK(sums_up_to_date());
+    leds[99] = CRGBW(0, 0, 0, 0);
+    power_track_changed(&leds[99], 1);
+    CHECK(sums_up_to_date());
+
+    // -- A whole block at full, the most its 16 bit sums hold
+    fill_solid(&leds[32], 32, CRGBW(255, 255, 255, 255));
+    CHECK(sums_up_to_date());
+
+    // -- A change nobody reported is caught, and corrected
+    leds[70].r ^= 0xFF;
+    CHECK(!sums_up_to_date());
+    CHECK(power_track_mismatches() == 1);
+    CHECK(sums_up_to_date());
+
+    // -- Reversed views whose ends are alone in their blocks: 64 (of 60 to
+    //    64) is the first led of block 2, 31 (of 31 to 36) the last of block 0
+    CPixelView<CRGBW> down(leds, 64, 60);
+    CHECK(down.reversed() && down.size() == 5);
+    down = CRGBW(5, 6, 7, 8);
+    CHECK(sums_up_to_date());
+    CPixelView<CRGBW> up(leds, 36, 31);
+    up = CRGBW(9, 10, 11, 12);
+    CHECK(sums_up_to_date());
+
+    // -- Changes made with tracking off, reported or not
+    set_power_tracking(false);
+    leds[10] = CRGBW(13, 14, 15, 16);
+    leds[80] = CRGBW(17, 18, 19, 20);
+    power_track_changed(&leds[80], 1);
+    set_power_tracking(true);
+    CHECK(sums_up_to_date());
+
+    CHECK(power_track_mismatches() == 1);
+
+    return test_result("power_track");
+}
@@ -0,0 +1,106 @@
+// Each power zone gets the brightness that keeps it under its own limit,
+// the result is the highest of the zones in use, showColor dims each
+// zone like show does, and the governor moves a zone's brightness no
+// faster than its attack and release times
+
+#include "FastLED.h"
+#include "test.h"
+
+// -- Records the scale it was last shown with
+class ScaleController : public CPixelLEDController<RGB> {
+public:
+    uint8_t scale;
+
+    virtual void init() {}
+    virtual void showPixels(PixelController<RGB> & pixels) { scale = pixels.mScale.r; }
+};
+
+static CRGBW leds0[50];
+static CRGBW leds1[50];
+static ScaleController controller0;
+static ScaleController controller1;
+
+// -- The brightness, up to 255, that keeps leds drawing unscaled_mW at
+//    full brightness under max_mW (as power_mgt.cpp works it out)
+static uint8_t brightness_for(uint32_t unscaled_mW, uint32_t max_mW)
+{
+    uint32_t requested_mW = unscaled_mW * 255 / 256;
+    return (requested_mW < max_mW) ? 255 : 255 * max_mW / requested_mW;
+}
+
+// -- Run the power function 10 ms after the last time
+static uint8_t step_10ms()
+{
+    rmt_sim_run(10 * 1000 * RMT_SIM_CYCLES_PER_US);
+    return calculate_max_brightness_for_power_mW(255, 1000000);
+}
+
+int main()
+{
+    fill_solid(leds0, 50, CRGBW(255, 255, 255, 255));
+    fill_solid(leds1, 50, CRGBW(255, 0, 0, 0));
+    FastLED.addLeds(&controller0, leds0, 50);
+    FastLED.addLeds(&controller1, leds1, 50).setPowerZone(1);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    uint32_t mW0 = calculate_unscaled_power_mW(leds0, 50);
+    uint32_t mW1 = calculate_unscaled_power_mW(leds1, 50);
+
+    // -- Both zones in use are limited, and zones 2 and 3 have no
+    //    controllers: the result is the brighter of zones 0 and 1
+    set_zone_max_power_in_milliwatts(0, mW0 / 4);
+    set_zone_max_power_in_milliwatts(1, mW1 / 2);
+    set_zone_max_power_in_milliwatts(3, 1);
+    uint8_t b = calculate_max_brightness_for_power_mW(255, 1000000);
+    CHECK(power_zone_brightness(0) == brightness_for(mW0, mW0 / 4));
+    CHECK(power_zone_brightness(1) == brightness_for(mW1, mW1 / 2));
+    CHECK(b == power_zone_brightness(1));
+    CHECK(b < 255);
+
+    // -- showColor gives each controller its own zone's brightness
+    FastLED.setMaxPowerInMilliWatts(1000000);
+    FastLED.showColor(CRGBW(255, 255, 255, 255));
+    CHECK(controller0.scale == power_zone_brightness(0));
+    CHECK(controller1.scale == power_zone_brightness(1));
+    CHECK(controller0.scale != controller1.scale);
+    FastLED.show();
+    CHECK(controller0.scale == power_zone_brightness(0));
+    CHECK(controller1.scale == power_zone_brightness(1));
+
+    // -- The governor: with the zone 0 limit at a quarter, the brightness
+    //    falls from 255 at 25.5 a step (10 ms of a 100 ms attack), and
+    //    comes back at 6.375 a step (10 ms of a 400 ms release)
+    set_zone_max_power_in_milliwatts(0, 0);
+    set_zone_max_power_in_milliwatts(1, 0);
+    set_zone_max_power_in_milliwatts(3, 0);
+    set_power_governor(10, 100, 400, 0);
+    CHECK(step_10ms() == 255);
+
+    set_zone_max_power_in_milliwatts(0, mW0 / 4);
+    uint8_t low = brightness_for(mW0, mW0 / 4);
+    step_10ms();
+    CHECK(power_zone_brightness(0) == 229);
+    CHECK(power_zone_brightness(1) == 255);
+    step_10ms();
+    CHECK(power_zone_brightness(0) == 204);
+    int steps = 2;
+    while (power_zone_brightness(0) > low && steps < 100) {
+        step_10ms();
+        steps++;
+    }
+    // -- (255 - low) / 25.5 steps, rounded up
+    CHECK(steps == ((255 - low) * 10 + 254) / 255);
+
+    set_zone_max_power_in_milliwatts(0, 0);
+    step_10ms();
+    CHECK(power_zone_brightness(0) == low + 6);
+    steps = 1;
+    while (power_zone_brightness(0) < 255 && steps < 100) {
+        step_10ms();
+        steps++;
+    }
+    // -- (255 - low) / 6.375 steps, rounded up
+    CHECK(steps == ((255 - low) * 1000 + 6374) / 6375);
+
+    return test_result("power_zones");
+}
@@ -0,0 +1,57 @@
+// The byte-to-pulse table gives the same pulses as converting each byte
+// a bit at a time, and the refill code sends every byte value correctly
+
+#include "FastLED.h"
+#include "test.h"
+
+#define T1 NS(300)
+#define T2 NS(300)
+#define T3 NS(600)
+
+static CRGBW leds[64];
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds, 64);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+
+    // -- The pulses for a zero and a one bit, as the controller makes them
+    rmt_item32_t zero, one;
+    one.level0 = 1;
+    one.duration0 = TO_RMT_CYCLES(T1 + T2);
+    one.level1 = 0;
+    one.duration1 = TO_RMT_CYCLES(T3);
+    zero.level0 = 1;
+    zero.duration0 = TO_RMT_CYCLES(T1);
+    zero.level1 = 0;
+    zero.duration1 = TO_RMT_CYCLES(T2 + T3);
+
+    // -- Each entry is the byte's bits, most significant first
+    const uint32_t * table = ClocklessRMTPulseTable<T1, T2, T3>::mPulses;
+    bool same = true;
+    for (int byteval = 0; byteval < 256; byteval++) {
+        uint32_t bit_mask = 0x80;
+        for (int j = 0; j < 8; j++) {
+            uint32_t item = (byteval & bit_mask) ? one.val : zero.val;
+            if (table[byteval * 8 + j] != item) same = false;
+            bit_mask >>= 1;
+        }
+    }
+    CHECK(same);
+
+    // -- All 256 byte values, through the refill code
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < 64; i++) {
+        leds[i] = CRGBW(4 * i, 4 * i + 1, 4 * i + 2, 4 * i + 3);
+        for (int j = 0; j < 4; j++) bytes.push_back(4 * i + j);
+    }
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(5, ONE_NS, LATCH_NS);
+    CHECK(frames.size() == 1);
+    CHECK(! frames.empty() && frames.back() == bytes);
+
+    return test_result("pulse_table");
+}
@@ -0,0 +1,94 @@
+// The RMT driver against the simulated RMT: what comes out on each pin
+// decodes back to the bytes for its leds
+
+#define FASTLED_RMT_MAX_CHANNELS 2
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[100];
+static CRGBW leds2[37];
+static CRGBW leds3[64];
+static CRGBW leds4[16];
+
+// -- The bytes a strip should get, scaled, in the given order of channels
+static std::vector<uint8_t> expected(const CRGBW * leds, int n, const int * order, int nBytes, uint8_t scale)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < nBytes; j++) bytes.push_back(scale8(leds[i].raw[order[j]], scale));
+    }
+    return bytes;
+}
+
+static const int RGBW_ORDER[] = { 0, 1, 2, 3 };
+static const int GRB_ORDER[] = { 1, 0, 2 };
+static const int WRGB_ORDER[] = { 3, 0, 1, 2 };
+
+static void check_frame(int pin, const std::vector<uint8_t> & bytes)
+{
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(pin, ONE_NS, LATCH_NS);
+    CHECK(frames.size() == 1);
+    CHECK(! frames.empty() && frames.back() == bytes);
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds1, 100);
+    FastLED.addLeds<WS2812, 18, GRB>(leds2, 37);
+    FastLED.addLeds<SK6812W, 19, RGB>(leds3, 64);
+    FastLED.addLeds<SK6812W, 21, WRGB>(leds4, 16);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+
+    random16_set_seed(1234);
+    for (int i = 0; i < 100; i++) leds1[i] = CRGBW(random8(), random8(), random8(), random8());
+    for (int i = 0; i < 37; i++) leds2[i] = CRGBW(random8(), random8(), random8(), 0);
+    for (int i = 0; i < 64; i++) leds3[i] = CRGBW(i, 255 - i, i * 3, i * 7);
+    for (int i = 0; i < 16; i++) leds4[i] = CRGBW(0x10 + i, 0x20 + i, 0x30 + i, 0xF0 + i);
+
+    // -- Full brightness: the RGBW strips are sent straight from the
+    //    leds, and the WRGB strip sends white first
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    check_frame(5, expected(leds1, 100, RGBW_ORDER, 4, 255));
+    check_frame(18, expected(leds2, 37, GRB_ORDER, 3, 255));
+    check_frame(19, expected(leds3, 64, RGBW_ORDER, 4, 255));
+    check_frame(21, expected(leds4, 16, WRGB_ORDER, 4, 255));
+    std::vector<std::vector<uint8_t> > wrgb = rmt_sim_decode(21, ONE_NS, LATCH_NS);
+    CHECK(! wrgb.empty() && wrgb[0].size() == 64 && wrgb[0][0] == 0xF0 && wrgb[0][1] == 0x10 && wrgb[0][4] == 0xF1);
+
+    // -- Every pulse has the chipset's timing: 300 or 600 ns high, and
+    //    1.2 us in all for SK6812
+    const std::vector<RMTSimRun> & runs = rmt_sim_waveform(5);
+    bool timing = true;
+    for (size_t i = 0; i + 1 < runs.size(); i += 2) {
+        if (runs[i].level != 1) { timing = false; break; }
+        if (runs[i].cycles != 72 && runs[i].cycles != 144) timing = false;
+        if (i + 2 < runs.size() && runs[i].cycles + runs[i + 1].cycles != 288) timing = false;
+    }
+    CHECK(timing);
+
+    // -- With two channels for four strips, the longest two go out at
+    //    once and the WS2812 strip when the shorter of them is done. The
+    //    100 leds take 3200 bits of 1.2 us, the low end of the last one
+    //    stretched to the 50 us latch.
+    const RMTFrameStats & stats = rmtFrameStats();
+    CHECK(stats.numControllers == 4);
+    CHECK(stats.queueDelay[0] < 10 && stats.queueDelay[2] < 10);
+    CHECK(stats.queueDelay[1] >= stats.sendTime[2]);
+    CHECK(stats.sendTime[0] >= 3885 && stats.sendTime[0] < 3895);
+
+    // -- Scaled: through the staging buffers
+    rmt_sim_clear_waveforms();
+    FastLED.setBrightness(100);
+    FastLED.show();
+    rmt_sim_run_until_idle();
+    check_frame(5, expected(leds1, 100, RGBW_ORDER, 4, 100));
+    check_frame(18, expected(leds2, 37, GRB_ORDER, 3, 100));
+    check_frame(19, expected(leds3, 64, RGBW_ORDER, 4, 100));
+    check_frame(21, expected(leds4, 16, WRGB_ORDER, 4, 100));
+
+    return test_result("rmt_sim");
+}
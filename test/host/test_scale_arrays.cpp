@@ -0,0 +1,42 @@
+// nscale8 and nscale8_video on CRGBW arrays, a pixel at a time, give the
+// same result as scale8 and scale8_video on every channel, for every scale,
+// on arrays that are and are not word aligned
+
+#include "FastLED.h"
+#include "test.h"
+
+#define NUM 37
+
+static uint8_t gSource[4 * NUM];
+static uint8_t gBuffer[4 * NUM + 4];
+
+template<bool VIDEO> static bool same_as_channelwise(int offset)
+{
+    CRGBW * leds = (CRGBW *)(gBuffer + offset);
+    for (int scale = 0; scale < 256; scale++) {
+        memcpy((void *)leds, gSource, sizeof(gSource));
+        if (VIDEO) nscale8_video(leds, NUM, scale);
+        else nscale8(leds, NUM, scale);
+
+        const uint8_t * out = (const uint8_t *)leds;
+        for (int i = 0; i < 4 * NUM; i++) {
+            uint8_t expected = VIDEO ? scale8_video(gSource[i], scale) : scale8(gSource[i], scale);
+            if (out[i] != expected) return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    random16_set_seed(7);
+    for (int i = 0; i < 4 * NUM; i++) gSource[i] = random8();
+    gSource[0] = 0; gSource[1] = 1; gSource[2] = 255; gSource[3] = 128;
+
+    for (int offset = 0; offset < 4; offset++) {
+        CHECK(same_as_channelwise<false>(offset));
+        CHECK(same_as_channelwise<true>(offset));
+    }
+
+    return test_result("scale_arrays");
+}
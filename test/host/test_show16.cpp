@@ -0,0 +1,52 @@
+// A controller without its own 16 bit path sends the nearest 8 bit values
+// of 16 bit leds, from a buffer allocated when the leds are attached
+
+#include "FastLED.h"
+#include "test.h"
+
+// -- Records what the controller would send
+class RecordingController : public CPixelLEDController<RGB> {
+public:
+    std::vector<CRGBW> sent;
+
+    using CPixelLEDController<RGB>::show16;
+
+    virtual void init() {}
+
+    virtual void showPixels(PixelController<RGB> & pixels)
+    {
+        sent.clear();
+        while (pixels.has(1)) {
+            sent.push_back(CRGBW(pixels.loadAndScale0(), pixels.loadAndScale1(), pixels.loadAndScale2(), pixels.loadAndScale3()));
+            pixels.advanceData();
+            pixels.stepDithering();
+        }
+    }
+};
+
+static CRGBW16 leds[20];
+static RecordingController controller;
+
+int main()
+{
+    for (int i = 0; i < 20; i++) leds[i] = CRGBW16(i * 3000, 65535 - i * 3000, i * 128 + 127, 0x80ff);
+
+    FastLED.addLeds(&controller, leds, 10);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+
+    FastLED.show();
+    bool same = (controller.sent.size() == 10);
+    for (int i = 0; i < 10 && same; i++) {
+        CRGBW expected = leds[i];
+        same = (controller.sent[i] == expected);
+    }
+    CHECK(same);
+
+    // -- More leds than were attached: the rest are not sent
+    controller.show16(leds, 20, CRGBW(255, 255, 255, 255));
+    CHECK(controller.sent.size() == 10);
+
+    return test_result("show16");
+}
@@ -0,0 +1,75 @@
+// FastLED.showAsync() returns while the frame is being sent, from a copy
+// of the leds; waitForShow() and the next show wait for it, and the done
+// callback runs once per frame, after the last pulse has gone out
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds[50];
+
+static int gDone = 0;
+static uint64_t gDoneAt = 0;
+
+static void show_done(void * arg)
+{
+    CHECK(arg == &gDone);
+    gDone++;
+    gDoneAt = rmt_sim_now();
+}
+
+static std::vector<uint8_t> bytes_of(const CRGBW * leds, int n)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 4; j++) bytes.push_back(leds[i].raw[j]);
+    }
+    return bytes;
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds, 50);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    FastLED.setShowDoneCallback(show_done, &gDone);
+
+    // -- A synchronous show returns when the frame is done
+    fill_solid(leds, 50, CRGBW(1, 2, 3, 4));
+    FastLED.show();
+    CHECK(gDone == 1);
+    CHECK(! FastLED.isShowing());
+
+    // -- showAsync returns right away, and the leds can change while the
+    //    frame goes out
+    rmt_sim_run_until_idle();
+    rmt_sim_clear_waveforms();
+    uint64_t start = rmt_sim_now();
+    for (int i = 0; i < 50; i++) leds[i] = CRGBW(i, 2 * i, 3 * i, 4 * i);
+    std::vector<uint8_t> frame1 = bytes_of(leds, 50);
+    FastLED.showAsync();
+    CHECK(FastLED.isShowing());
+    CHECK(gDone == 1);
+    fill_solid(leds, 50, CRGBW(9, 9, 9, 9));
+
+    FastLED.waitForShow();
+    CHECK(! FastLED.isShowing());
+    CHECK(gDone == 2);
+    // -- No earlier than 50 leds of 32 bits, at 288 cycles a bit, take
+    CHECK(gDoneAt - start >= 50 * 32 * 288);
+
+    // -- The next show waits for a frame in flight before it starts
+    std::vector<uint8_t> frame2 = bytes_of(leds, 50);
+    FastLED.showAsync();
+    fill_solid(leds, 50, CRGBW(5, 6, 7, 8));
+    std::vector<uint8_t> frame3 = bytes_of(leds, 50);
+    FastLED.show();
+    CHECK(gDone == 4);
+    CHECK(! FastLED.isShowing());
+
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(5, ONE_NS, LATCH_NS);
+    CHECK(frames.size() == 3);
+    CHECK(frames.size() == 3 && frames[0] == frame1 && frames[1] == frame2 && frames[2] == frame3);
+
+    return test_result("show_async");
+}
@@ -0,0 +1,78 @@
+// FastLED.showDirty() sends only the controllers marked with markDirty():
+// the others take no channel and put nothing on their pins, and a frame
+// with nothing to send still completes and runs the done callback
+
+#define FASTLED_RMT_MAX_CHANNELS 1
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[40];
+static CRGBW leds2[20];
+
+static int gDone = 0;
+
+static void show_done(void *) { gDone++; }
+
+static std::vector<uint8_t> bytes_of(const CRGBW * leds, int n)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 4; j++) bytes.push_back(leds[i].raw[j]);
+    }
+    return bytes;
+}
+
+int main()
+{
+    CLEDController & strip1 = FastLED.addLeds<SK6812W, 5, RGB>(leds1, 40);
+    CLEDController & strip2 = FastLED.addLeds<SK6812W, 18, RGB>(leds2, 20);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    FastLED.setShowDoneCallback(show_done, NULL);
+    fill_solid(leds1, 40, CRGBW(1, 2, 3, 4));
+    fill_solid(leds2, 20, CRGBW(5, 6, 7, 8));
+
+    // -- Every controller starts out dirty, and show() leaves them clean
+    FastLED.show();
+    CHECK(gDone == 1);
+    CHECK(! strip1.isDirty() && ! strip2.isDirty());
+
+    // -- Only the second strip: it goes out at once on the one channel,
+    //    and the first strip's pin stays idle
+    rmt_sim_run_until_idle();
+    rmt_sim_clear_waveforms();
+    fill_solid(leds2, 20, CRGBW(9, 10, 11, 12));
+    strip2.markDirty();
+    FastLED.showDirty();
+    rmt_sim_run_until_idle();
+    CHECK(gDone == 2);
+    CHECK(! strip2.isDirty());
+    CHECK(rmt_sim_waveform(5).empty());
+    CHECK(rmt_sim_decode(18, ONE_NS, LATCH_NS) == std::vector<std::vector<uint8_t> >(1, bytes_of(leds2, 20)));
+    const RMTFrameStats & stats = rmtFrameStats();
+    CHECK(stats.queueDelay[1] < 10);
+    CHECK(stats.sendTime[0] == 0);
+    // -- 20 leds of 32 bits at 1.2 us, and the latch
+    CHECK(stats.wireTime < 20 * 32 * 12 / 10 + 100);
+
+    // -- Nothing dirty: the frame completes without sending anything,
+    //    after an asynchronous frame in flight
+    rmt_sim_clear_waveforms();
+    FastLED.showAsync();
+    CHECK(FastLED.isShowing());
+    FastLED.showDirty();
+    CHECK(! FastLED.isShowing());
+    CHECK(gDone == 4);
+    CHECK(stats.wireTime == 0);
+    CHECK(rmt_sim_decode(5, ONE_NS, LATCH_NS).size() == 1);
+    CHECK(rmt_sim_decode(18, ONE_NS, LATCH_NS).size() == 1);
+    FastLED.showDirty();
+    rmt_sim_run_until_idle();
+    CHECK(gDone == 5);
+    CHECK(rmt_sim_decode(5, ONE_NS, LATCH_NS).size() == 1);
+    CHECK(rmt_sim_decode(18, ONE_NS, LATCH_NS).size() == 1);
+
+    return test_result("show_dirty");
+}
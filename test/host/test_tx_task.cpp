@@ -0,0 +1,79 @@
+// With the transmit task, show() hands each frame to a task on the other
+// core through the two-slot queue: the task owns the RMT interrupt, a
+// second frame can be queued while the first is on the wire, and each
+// frame goes out as it was when it was shown
+
+#define FASTLED_RMT_TX_TASK 1
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds1[50];
+static CRGBW leds2[20];
+
+static int gDone = 0;
+
+static void show_done(void *) { gDone++; }
+
+// -- The bytes a strip should get at brightness 200 (which keeps the
+//    frame from being sent straight from the leds)
+static std::vector<uint8_t> expected(const CRGBW * leds, int n)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 4; j++) bytes.push_back(scale8(leds[i].raw[j], 200));
+    }
+    return bytes;
+}
+
+static void fill_frame(int frame)
+{
+    for (int i = 0; i < 50; i++) leds1[i] = CRGBW(frame, i, 3 * i + frame, 255 - i);
+    for (int i = 0; i < 20; i++) leds2[i] = CRGBW(i, frame, 7 * frame, i + frame);
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds1, 50);
+    FastLED.addLeds<SK6812W, 18, RGB>(leds2, 20);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    FastLED.setBrightness(200);
+    FastLED.setMaxRefreshRate(0);
+    FastLED.setShowDoneCallback(show_done, NULL);
+
+    // -- A synchronous show returns when the task has sent the frame, and
+    //    the interrupt is on the task's core
+    std::vector<std::vector<uint8_t> > sent1, sent2;
+    fill_frame(1);
+    sent1.push_back(expected(leds1, 50));
+    sent2.push_back(expected(leds2, 20));
+    FastLED.show();
+    CHECK(! FastLED.isShowing());
+    CHECK(gDone == 1);
+    CHECK(rmt_sim_intr_core() == 1);
+
+    // -- Back to back: the second frame is queued while the first is
+    //    still being sent (50 leds of 32 bits at 288 cycles a bit), and
+    //    the third waits for the first to be done
+    uint64_t start = rmt_sim_now();
+    for (int frame = 2; frame <= 4; frame++) {
+        fill_frame(frame);
+        sent1.push_back(expected(leds1, 50));
+        sent2.push_back(expected(leds2, 20));
+        FastLED.showAsync();
+        CHECK(FastLED.isShowing());
+        if (frame == 3) CHECK(rmt_sim_now() - start < 50 * 32 * 288);
+        if (frame == 4) CHECK(rmt_sim_now() - start >= 50 * 32 * 288);
+        fill_frame(100 + frame);
+    }
+    FastLED.waitForShow();
+    CHECK(! FastLED.isShowing());
+    CHECK(gDone == 4);
+    rmt_sim_run_until_idle();
+    CHECK(rmt_sim_decode(5, ONE_NS, LATCH_NS) == sent1);
+    CHECK(rmt_sim_decode(18, ONE_NS, LATCH_NS) == sent2);
+
+    return test_result("tx_task");
+}
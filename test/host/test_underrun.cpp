@@ -0,0 +1,82 @@
+// A late refill is detected and the frame sent again, from the interrupt
+// handler without the IDF calls; and the timing holds when show() runs
+// on the other core, whose cycle counter reads differently
+
+#include "FastLED.h"
+#include "test.h"
+
+static CRGBW leds[100];
+
+// -- 32 pulses of 288 cycles: how long half the RMT buffer lasts
+#define HALF_CYCLES (32 * 288)
+
+static std::vector<uint8_t> bytes_of(const CRGBW * leds, int n)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 4; j++) bytes.push_back(leds[i].raw[j]);
+    }
+    return bytes;
+}
+
+static void show()
+{
+    rmt_sim_clear_waveforms();
+    FastLED.show();
+    rmt_sim_run_until_idle();
+}
+
+static void check_frame(const std::vector<uint8_t> & bytes)
+{
+    std::vector<std::vector<uint8_t> > frames = rmt_sim_decode(5, ONE_NS, LATCH_NS);
+    CHECK(! frames.empty() && frames.back() == bytes);
+}
+
+int main()
+{
+    FastLED.addLeds<SK6812W, 5, RGB>(leds, 100);
+    FastLED.setDither(DISABLE_DITHER);
+    FastLED.setCorrection(CRGBW(255, 255, 255, 255));
+    FastLED.setTemperature(CRGBW(255, 255, 255, 255));
+    for (int i = 0; i < 100; i++) leds[i] = CRGBW(i, 100 - i, 2 * i, 7);
+    std::vector<uint8_t> bytes = bytes_of(leds, 100);
+    const RMTChannelCounters & counters = rmtChannelCounters();
+
+    // -- On time, nothing is resent
+    show();
+    check_frame(bytes);
+    CHECK(counters.underruns[0] == 0);
+
+    // -- The third interrupt comes more than half a buffer late: the
+    //    frame is resent after a latch, and the strip ends up with the
+    //    right data
+    rmt_sim_delay_intr(2, HALF_CYCLES + 1000);
+    show();
+    check_frame(bytes);
+    CHECK(counters.underruns[0] == 1);
+    CHECK(counters.retries[0] == 1);
+    CHECK(rmt_sim_isr_idf_calls() == 0);
+
+    // -- Late, but not by enough to matter
+    rmt_sim_delay_intr(2, HALF_CYCLES / 2);
+    show();
+    check_frame(bytes);
+    CHECK(counters.underruns[0] == 1);
+
+    // -- show() on core 1, whose cycle counter is far from core 0's,
+    //    where the interrupt handler runs
+    rmt_sim_set_core(1);
+    rmt_sim_set_ccount_offset(0x80000000);
+    show();
+    check_frame(bytes);
+    CHECK(counters.underruns[0] == 1);
+
+    rmt_sim_delay_intr(2, HALF_CYCLES + 1000);
+    show();
+    check_frame(bytes);
+    CHECK(counters.underruns[0] == 2);
+    CHECK(counters.retries[0] == 2);
+    CHECK(rmt_sim_isr_idf_calls() == 0);
+
+    return test_result("underrun");
+}
@@ -0,0 +1,99 @@
+// compile_xy_layout gives the same table as walking the chain led by led
+// and turning each panel as it is mounted, for every rotation, serpentine
+// setting, panel order and gap, and the 16 bit version refuses chains
+// longer than 65536 leds
+
+#include <vector>
+#include "FastLED.h"
+#include "test.h"
+
+// -- Follow the chain from its first led, putting each led's index at the
+//    position it ends up at once its panel is turned and put in place
+static std::vector<uint32_t> walk_chain(const CXYLayout & layout)
+{
+    uint16_t pw = layout.panelWidth;
+    uint16_t ph = layout.panelHeight;
+    uint16_t mw = (layout.rotation & 1) ? ph : pw;
+    uint16_t mh = (layout.rotation & 1) ? pw : ph;
+    std::vector<uint32_t> table(layout.size(), 0xFFFFFFFF);
+
+    uint32_t index = 0;
+    for (int k = 0; k < layout.panelsAcross * layout.panelsDown; k++) {
+        int py = k / layout.panelsAcross;
+        int px = k % layout.panelsAcross;
+        if (layout.panelSerpentine && (py & 1)) px = layout.panelsAcross - 1 - px;
+
+        for (int v = 0; v < ph; v++) {
+            for (int c = 0; c < pw; c++) {
+                int u = (layout.serpentine && (v & 1)) ? pw - 1 - c : c;
+                // -- (u, v) as wired, turned clockwise a quarter at a time
+                int x = u, y = v, h = ph, w = pw;
+                for (int r = 0; r < (layout.rotation & 3); r++) {
+                    int turned = h - 1 - y;
+                    y = x;
+                    x = turned;
+                    std::swap(w, h);
+                }
+                table[(uint32_t)(py * mh + y) * layout.width() + px * mw + x] = index++;
+            }
+        }
+        index += layout.gap;
+    }
+    return table;
+}
+
+static bool compiles_as_walked(const CXYLayout & layout)
+{
+    std::vector<uint32_t> expected = walk_chain(layout);
+    std::vector<uint32_t> table32(layout.size());
+    std::vector<uint16_t> table16(layout.size());
+    compile_xy_layout(layout, &table32[0]);
+    if (!compile_xy_layout(layout, &table16[0])) return false;
+    if (table32 != expected) return false;
+    for (uint32_t i = 0; i < layout.size(); i++) {
+        if (table16[i] != expected[i]) return false;
+    }
+
+    CXYMap map(layout, &table16[0]);
+    return map.width() == layout.width() && map.height() == layout.height() && map.numLeds() == layout.numLeds() &&
+           map(layout.width() - 1, layout.height() - 1) == expected[layout.size() - 1];
+}
+
+static bool all_layouts_compile_as_walked()
+{
+    static const uint16_t sizes[][2] = { { 1, 1 }, { 4, 1 }, { 1, 3 }, { 3, 2 }, { 4, 5 } };
+    for (int s = 0; s < 5; s++)
+        for (int rotation = 0; rotation < 4; rotation++)
+            for (int across = 1; across <= 3; across++)
+                for (int down = 1; down <= 3; down++)
+                    for (int flags = 0; flags < 8; flags++) {
+                        CXYLayout layout(sizes[s][0], sizes[s][1], across, down, flags & 1, rotation, flags & 2, (flags & 4) ? 7 : 0);
+                        if (!compiles_as_walked(layout)) return false;
+                    }
+    return true;
+}
+
+int main()
+{
+    CHECK(all_layouts_compile_as_walked());
+
+    // -- A 2x2 wall of 8x8 panels turned a quarter, serpentine both ways
+    CHECK(compiles_as_walked(CXYLayout(8, 8, 2, 2, true, 1, true, 3)));
+    CHECK(CXYLayout(8, 8, 2, 2, true, 1, true, 3).numLeds() == 4 * 64 + 3 * 3);
+
+    // -- The longest chain 16 bit indices can hold, and one led more
+    CXYLayout longest(256, 128, 1, 2);
+    CHECK(longest.numLeds() == 65536);
+    CHECK(compiles_as_walked(longest));
+
+    CXYLayout tooLong(256, 128, 1, 2, false, 0, false, 1);
+    std::vector<uint16_t> table16(tooLong.size(), 0x5555);
+    CHECK(!compile_xy_layout(tooLong, &table16[0]));
+    CHECK(table16 == std::vector<uint16_t>(tooLong.size(), 0x5555));
+    std::vector<uint32_t> table32(tooLong.size());
+    compile_xy_layout(tooLong, &table32[0]);
+    CHECK(table32 == walk_chain(tooLong));
+    CHECK(table32.back() == 65536);
+
+    return test_result("xy_layout");
+}
@@ -0,0 +1,193 @@
+// The 2D blurs and noise fills give the same result through any CXYMap
+// (plain, serpentine, or a table of 16 or 32 bit indices, up to 512x512)
+// as they would on a matrix in plain rows, with each led moved to where
+// the map puts it
+
+#include <vector>
+#include "FastLED.h"
+#include "test.h"
+
+typedef std::vector<CRGBW> Leds;
+
+// -- The XY() the XY-based 2D functions use: serpentine, 16 wide
+uint16_t XY(uint8_t x, uint8_t y) { return (y & 1) ? (uint16_t)y * 16 + 15 - x : (uint16_t)y * 16 + x; }
+
+static uint32_t random32() { return ((uint32_t)random16() << 16) | random16(); }
+
+static void random_leds(Leds & leds)
+{
+    for (size_t i = 0; i < leds.size(); i++) leds[i] = CRGBW(random8(), random8(), random8(), random8());
+}
+
+// -- A table sending the matrix, in a random order, to numLeds leds
+template<typename T> static std::vector<T> random_table(uint32_t size, uint32_t numLeds)
+{
+    std::vector<T> all(numLeds);
+    for (uint32_t i = 0; i < numLeds; i++) all[i] = i;
+    for (uint32_t i = numLeds - 1; i > 0; i--) std::swap(all[i], all[random32() % (i + 1)]);
+    return std::vector<T>(all.begin(), all.begin() + size);
+}
+
+// -- The matrix in plain rows, and back again
+static Leds gather(const Leds & leds, const CXYMap & map)
+{
+    Leds plain(map.size());
+    for (uint16_t y = 0; y < map.height(); y++)
+        for (uint16_t x = 0; x < map.width(); x++) plain[(uint32_t)y * map.width() + x] = leds[map(x, y)];
+    return plain;
+}
+
+static void scatter(const Leds & plain, Leds & leds, const CXYMap & map)
+{
+    for (uint16_t y = 0; y < map.height(); y++)
+        for (uint16_t x = 0; x < map.width(); x++) leds[map(x, y)] = plain[(uint32_t)y * map.width() + x];
+}
+
+// -- blur1d along each row, and down each column, of a matrix in plain rows
+static void reference_rows(Leds & plain, uint16_t width, uint16_t height, fract8 amount)
+{
+    for (uint16_t y = 0; y < height; y++) blur1d(&plain[(uint32_t)y * width], width, amount);
+}
+
+static void reference_columns(Leds & plain, uint16_t width, uint16_t height, fract8 amount)
+{
+    Leds column(height);
+    for (uint16_t x = 0; x < width; x++) {
+        for (uint16_t y = 0; y < height; y++) column[y] = plain[(uint32_t)y * width + x];
+        blur1d(&column[0], height, amount);
+        for (uint16_t y = 0; y < height; y++) plain[(uint32_t)y * width + x] = column[y];
+    }
+}
+
+enum { BLUR_2D, BLUR_ROWS, BLUR_COLUMNS };
+
+static bool blur_matches(const CXYMap & map, int which)
+{
+    static const uint8_t amounts[] = { 0, 1, 64, 172, 255 };
+    Leds leds(map.numLeds());
+    for (int a = 0; a < 5; a++) {
+        random_leds(leds);
+        Leds expected = leds;
+        Leds plain = gather(leds, map);
+        if (which != BLUR_COLUMNS) reference_rows(plain, map.width(), map.height(), amounts[a]);
+        if (which != BLUR_ROWS) reference_columns(plain, map.width(), map.height(), amounts[a]);
+        scatter(plain, expected, map);
+
+        if (which == BLUR_2D) blur2d(&leds[0], map, amounts[a]);
+        if (which == BLUR_ROWS) blurRows(&leds[0], map, amounts[a]);
+        if (which == BLUR_COLUMNS) blurColumns(&leds[0], map, amounts[a]);
+        if (leds != expected) return false;
+    }
+    return true;
+}
+
+static bool blur_all_matches(const CXYMap & map)
+{
+    return blur_matches(map, BLUR_2D) && blur_matches(map, BLUR_ROWS) && blur_matches(map, BLUR_COLUMNS);
+}
+
+// -- The XY-based blur2d against the same layout as a map
+static bool xy_blur_matches(uint16_t width, uint16_t height, bool serpentine)
+{
+    Leds leds((uint32_t)width * height);
+    random_leds(leds);
+    Leds expected = leds;
+    blur2d(&leds[0], width, height, 100);
+    blur2d(&expected[0], CXYMap(width, height, serpentine), 100);
+    return leds == expected;
+}
+
+// -- What fill_2dnoise8 and fill_2dnoise16 gave before they took a map,
+//    on a matrix in plain rows
+static Leds reference_noise(bool sixteen, uint16_t width, uint16_t height, const Leds & before, bool blend)
+{
+    uint32_t size = (uint32_t)width * height;
+    std::vector<uint8_t> V(size), H(size);
+    if (sixteen) fill_raw_2dnoise16into8(&V[0], width, height, 4, q44(2, 0), 171, 1, 0x12345, 300, 0x6789, 500, 77);
+    else fill_raw_2dnoise8(&V[0], width, height, 4, 1234, 300, 5678, 500, 77);
+    fill_raw_2dnoise8(&H[0], width, height, 2, 999, 40, 888, 50, 33);
+
+    Leds plain(before);
+    for (uint16_t i = 0; i < height; i++) {
+        for (uint16_t j = 0; j < width; j++) {
+            uint8_t hue = H[(uint32_t)(height - 1 - i) * width + width - 1 - j];
+            CRGBW led(sixteen ? CHSV((0x4000 >> 8) + hue, 196, V[(uint32_t)i * width + j]) : CHSV(hue, 255, V[(uint32_t)i * width + j]));
+            CRGBW & pos = plain[(uint32_t)i * width + j];
+            if (blend) {
+                pos >>= 1; pos += (led >>= 1);
+            } else {
+                pos = led;
+            }
+        }
+    }
+    return plain;
+}
+
+static void noise(bool sixteen, CRGBW * leds, const CXYMap & map, bool blend)
+{
+    if (sixteen) fill_2dnoise16(leds, map, 4, 0x12345, 300, 0x6789, 500, 77, 2, 999, 40, 888, 50, 33, blend, 0x4000);
+    else fill_2dnoise8(leds, map, 4, 1234, 300, 5678, 500, 77, 2, 999, 40, 888, 50, 33, blend);
+}
+
+static bool noise_matches(const CXYMap & map)
+{
+    Leds leds(map.numLeds());
+    for (int sixteen = 0; sixteen < 2; sixteen++) {
+        for (int blend = 0; blend < 2; blend++) {
+            random_leds(leds);
+            Leds expected = leds;
+            scatter(reference_noise(sixteen, map.width(), map.height(), gather(leds, map), blend), expected, map);
+            noise(sixteen, &leds[0], map, blend);
+            if (leds != expected) return false;
+        }
+    }
+    return true;
+}
+
+// -- The width, height, serpentine versions against the same layout as a map
+static bool serpentine_noise_matches(uint16_t width, uint16_t height)
+{
+    Leds leds((uint32_t)width * height);
+    random_leds(leds);
+    Leds expected = leds;
+    fill_2dnoise8(&leds[0], width, height, true, 4, 1234, 300, 5678, 500, 77, 2, 999, 40, 888, 50, 33, true);
+    fill_2dnoise8(&expected[0], CXYMap(width, height, true), 4, 1234, 300, 5678, 500, 77, 2, 999, 40, 888, 50, 33, true);
+    if (leds != expected) return false;
+    fill_2dnoise16(&leds[0], width, height, true, 4, 0x12345, 300, 0x6789, 500, 77, 2, 999, 40, 888, 50, 33, false, 0x4000);
+    fill_2dnoise16(&expected[0], CXYMap(width, height, true), 4, 0x12345, 300, 0x6789, 500, 77, 2, 999, 40, 888, 50, 33, false, 0x4000);
+    return leds == expected;
+}
+
+int main()
+{
+    random16_set_seed(24);
+
+    // -- Plain and serpentine, including a single row and a single column
+    CHECK(blur_all_matches(CXYMap(7, 5)));
+    CHECK(blur_all_matches(CXYMap(16, 9, true)));
+    CHECK(blur_all_matches(CXYMap(1, 12, true)));
+    CHECK(blur_all_matches(CXYMap(12, 1)));
+
+    // -- Tables, with leds in the array that are not in the matrix (which
+    //    must be left alone)
+    std::vector<uint16_t> table16 = random_table<uint16_t>(20 * 13, 20 * 13 + 17);
+    CXYMap map16(20, 13, &table16[0], 20 * 13 + 17);
+    CHECK(blur_all_matches(map16));
+    std::vector<uint32_t> table32 = random_table<uint32_t>(512 * 512, 512 * 512);
+    CXYMap map32(512, 512, &table32[0]);
+    CHECK(blur_matches(map32, BLUR_2D));
+    CHECK(blur_all_matches(CXYMap(512, 512, true)));
+
+    // -- The application's XY() up to 256 on a side, plain rows beyond
+    CHECK(xy_blur_matches(16, 16, true));
+    CHECK(xy_blur_matches(300, 3, false));
+
+    CHECK(noise_matches(CXYMap(7, 5)));
+    CHECK(noise_matches(CXYMap(16, 9, true)));
+    CHECK(noise_matches(map16));
+    CHECK(noise_matches(map32));
+    CHECK(serpentine_noise_matches(16, 9));
+    CHECK(serpentine_noise_matches(512, 512));
+
+    return test_result("xymap");
+}
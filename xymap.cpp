@@ -0,0 +1,58 @@
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+
+FASTLED_NAMESPACE_BEGIN
+
+// Fill in the table entries for every led of every panel.  Works panel by
+// panel, going over each panel in the order it is mounted and turning each
+// position back into the row and column the panel was wired in.
+template<class T> static void compile_layout(const CXYLayout &layout, T *table)
+{
+    uint16_t pw = layout.panelWidth;
+    uint16_t ph = layout.panelHeight;
+    uint8_t rotation = layout.rotation & 3;
+    // -- the size of a panel as mounted
+    uint16_t mw = (rotation & 1) ? ph : pw;
+    uint16_t mh = (rotation & 1) ? pw : ph;
+    uint16_t width = layout.width();
+    uint32_t stride = (uint32_t)pw * ph + layout.gap;
+
+    for(uint8_t py = 0; py < layout.panelsDown; py++) {
+        for(uint8_t px = 0; px < layout.panelsAcross; px++) {
+            // -- where this panel starts in the chain
+            uint8_t n = (layout.panelSerpentine && (py & 1)) ? layout.panelsAcross - 1 - px : px;
+            uint32_t base = ((uint32_t)py * layout.panelsAcross + n) * stride;
+            T *out = table + (uint32_t)py * mh * width + (uint32_t)px * mw;
+
+            for(uint16_t y = 0; y < mh; y++) {
+                for(uint16_t x = 0; x < mw; x++) {
+                    // -- undo the rotation, giving the column u and row v as wired
+                    uint16_t u, v;
+                    switch(rotation) {
+                        case 0: u = x; v = y; break;
+                        case 1: u = y; v = ph - 1 - x; break;
+                        case 2: u = pw - 1 - x; v = ph - 1 - y; break;
+                        default: u = pw - 1 - y; v = x; break;
+                    }
+                    if(layout.serpentine && (v & 1)) { u = pw - 1 - u; }
+                    out[x] = base + (uint32_t)v * pw + u;
+                }
+                out += width;
+            }
+        }
+    }
+}
+
+bool compile_xy_layout(const CXYLayout &layout, uint16_t *table)
+{
+    if(layout.numLeds() > 65536) { return false; }
+    compile_layout(layout, table);
+    return true;
+}
+
+void compile_xy_layout(const CXYLayout &layout, uint32_t *table)
+{
+    compile_layout(layout, table);
+}
+
+FASTLED_NAMESPACE_END